@@ -0,0 +1,134 @@
+#include "benchReport.h"
+#include "algorithm"
+#include "format"
+#include "fstream"
+#include "print"
+#include "sstream"
+#include "string_view"
+
+namespace bench {
+    void BenchReport::add(const std::string& name, double value, const std::string& unit, bool higherIsBetter) {
+        std::println("{:<40} {:>14.3f} {}", name, value, unit);
+        m_Results.push_back({ name, value, unit, higherIsBetter });
+    }
+
+    std::string BenchReport::toJson() const {
+        std::string json = "{\n  \"results\": [\n";
+        for (size_t i = 0; i < m_Results.size(); ++i) {
+            const BenchResult& result = m_Results[i];
+            json += std::format(
+                "    {{ \"name\": \"{}\", \"value\": {}, \"unit\": \"{}\", \"higher_is_better\": {} }}{}\n",
+                result.Name,
+                result.Value,
+                result.Unit,
+                result.HigherIsBetter ? "true" : "false",
+                i + 1 < m_Results.size() ? "," : "");
+        }
+        json += "  ]\n}\n";
+        return json;
+    }
+
+    bool BenchReport::writeJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        file << toJson();
+        return static_cast<bool>(file);
+    }
+
+    // Only understands the flat layout written by toJson: every "name" is followed by its "value"
+    bool readBaseline(const std::string& path, std::vector<BenchResult>& outResults) {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string json = buffer.str();
+
+        size_t position = 0;
+        while ((position = json.find("\"name\"", position)) != std::string::npos) {
+            const size_t nameStart = json.find('"', json.find(':', position) + 1) + 1;
+            const size_t nameEnd = json.find('"', nameStart);
+            const size_t valueKey = json.find("\"value\"", nameEnd);
+            if (nameStart == std::string::npos || nameEnd == std::string::npos || valueKey == std::string::npos) {
+                return false;
+            }
+
+            BenchResult result{};
+            result.Name = json.substr(nameStart, nameEnd - nameStart);
+            result.Value = std::stod(json.substr(json.find(':', valueKey) + 1));
+            outResults.push_back(result);
+            position = valueKey;
+        }
+
+        return true;
+    }
+
+    int32_t BenchReport::compare(const std::string& baselinePath, double threshold) const {
+        std::vector<BenchResult> baseline;
+        if (!readBaseline(baselinePath, baseline)) {
+            return -1;
+        }
+
+        int32_t regressions = 0;
+        for (const BenchResult& result : m_Results) {
+            const auto iter = std::find_if(baseline.begin(), baseline.end(), [&result](const BenchResult& b) { return b.Name == result.Name; });
+            if (iter == baseline.end() || iter->Value <= 0.0) {
+                continue;
+            }
+
+            // Positive change is an improvement for both kinds of results
+            const double ratio = result.Value / iter->Value;
+            const double change = result.HigherIsBetter ? ratio - 1.0 : 1.0 - ratio;
+            const bool regressed = change < -threshold;
+            std::println("{:<40} {:>+8.1f}% {}", result.Name, change * 100.0, regressed ? "REGRESSED" : "ok");
+            regressions += regressed ? 1 : 0;
+        }
+
+        return regressions;
+    }
+
+    bool parseBenchArgs(int argc, char** argv, BenchArgs& outArgs) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--out" && hasValue) {
+                outArgs.OutPath = argv[++i];
+            } else if (arg == "--baseline" && hasValue) {
+                outArgs.BaselinePath = argv[++i];
+            } else if (arg == "--threshold" && hasValue) {
+                outArgs.Threshold = std::stod(argv[++i]);
+            } else if (arg == "--min-seconds" && hasValue) {
+                outArgs.MinSeconds = std::stod(argv[++i]);
+            } else {
+                std::println("Usage: {} [--out <report.json>] [--baseline <baseline.json>] [--threshold <0.1>] [--min-seconds <seconds>]", argv[0]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int finishBenchReport(const BenchReport& report, const BenchArgs& args) {
+        if (!args.OutPath.empty() && !report.writeJson(args.OutPath)) {
+            std::println("Failed to write {}", args.OutPath);
+            return 1;
+        }
+
+        if (!args.BaselinePath.empty()) {
+            const int32_t regressions = report.compare(args.BaselinePath, args.Threshold);
+            if (regressions < 0) {
+                std::println("Failed to read baseline {}", args.BaselinePath);
+                return 1;
+            }
+
+            return regressions == 0 ? 0 : 1;
+        }
+
+        return 0;
+    }
+} // namespace bench
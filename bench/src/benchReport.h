@@ -0,0 +1,57 @@
+#pragma once
+
+#include "string"
+#include "vector"
+
+namespace bench {
+    struct BenchResult {
+        std::string Name;
+        double Value{};
+        std::string Unit;
+
+        /** Rates are better when higher, timings when lower */
+        bool HigherIsBetter{ true };
+    };
+
+    class BenchReport {
+    public:
+        void add(const std::string& name, double value, const std::string& unit, bool higherIsBetter);
+
+        inline const std::vector<BenchResult>& getResults() const { return m_Results; }
+
+        std::string toJson() const;
+        bool writeJson(const std::string& path) const;
+
+        /**
+         * Compare against results loaded from a JSON file written by writeJson.
+         * A result regresses when it is worse than the baseline by more than threshold (0.1 = 10%).
+         * @return Number of regressed results, or -1 if the baseline can't be read
+         */
+        int32_t compare(const std::string& baselinePath, double threshold) const;
+
+    private:
+        std::vector<BenchResult> m_Results;
+    };
+
+    /** Read name/value pairs of a JSON report written by BenchReport */
+    bool readBaseline(const std::string& path, std::vector<BenchResult>& outResults);
+
+    /** Command line shared by the benchmark executables */
+    struct BenchArgs {
+        std::string OutPath;
+        std::string BaselinePath;
+        double Threshold{ 0.1 };
+
+        /** Minimum time every benchmark runs for. Non-positive keeps the default of the executable. */
+        double MinSeconds{ 0.0 };
+    };
+
+    /** Parse --out, --baseline, --threshold and --min-seconds. Prints the usage and returns false on unknown arguments. */
+    bool parseBenchArgs(int argc, char** argv, BenchArgs& outArgs);
+
+    /**
+     * Write the report and compare it against the baseline as requested by args.
+     * @return Process exit code, non-zero on write failure or regressions
+     */
+    int finishBenchReport(const BenchReport& report, const BenchArgs& args);
+} // namespace bench
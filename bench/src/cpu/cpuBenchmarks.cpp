@@ -0,0 +1,234 @@
+#include "cpuBenchmarks.h"
+#include "glStubs.h"
+#include "glass/glass.h"
+#include "glass/hashHelpers.h"
+#include "context/glShader.h"
+#include "context/glTexture.h"
+#include "context/glBuffer.h"
+#include "context/glFrameBuffer.h"
+#include "chrono"
+#include "cstring"
+#include "format"
+
+namespace gfx = glass::gfx;
+namespace gp = glass::platform;
+
+namespace bench {
+    using Clock = std::chrono::steady_clock;
+
+    // Results are folded in here so the optimizer can't drop the measured work
+    static volatile uint64_t GSink = 0;
+
+    /**
+     * Call op(i) in batches of batchSize until MinSeconds passed.
+     * @return Average nanoseconds per call
+     */
+    template <typename Op>
+    static double measureNanoseconds(const CpuBenchOptions& options, uint32_t batchSize, Op&& op) {
+        uint64_t sink = 0;
+        for (uint32_t i = 0; i < batchSize; ++i) {
+            sink += op(i);
+        }
+
+        uint64_t calls = 0;
+        const Clock::time_point start = Clock::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            for (uint32_t i = 0; i < batchSize; ++i) {
+                sink += op(i);
+            }
+            calls += batchSize;
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < options.MinSeconds);
+
+        GSink = GSink + sink;
+        return elapsed.count() * 1e9 / static_cast<double>(calls);
+    }
+
+    static constexpr const char* UNIFORM_NAMES[] = {
+        "uModel", "uView", "uProjection", "uViewProjection", "uNormalMatrix", "uCameraPosition", "uTime", "uAlbedoTexture",
+        "uNormalTexture", "uRoughnessTexture", "uLightDirection", "uLightColor", "uShadowMap", "uShadowMatrix", "uExposure", "uGamma",
+    };
+    static constexpr uint32_t UNIFORM_COUNT = std::size(UNIFORM_NAMES);
+
+    static constexpr glass::hash::CTStringHash HASHED_UNIFORM_NAMES[] = {
+        "uModel", "uView", "uProjection", "uViewProjection", "uNormalMatrix", "uCameraPosition", "uTime", "uAlbedoTexture",
+        "uNormalTexture", "uRoughnessTexture", "uLightDirection", "uLightColor", "uShadowMap", "uShadowMatrix", "uExposure", "uGamma",
+    };
+
+    static void benchmarkUniformLocations(BenchReport& report, const CpuBenchOptions& options) {
+        // Reflected programs answer every lookup from their uniform table
+        setStubProgramUniforms(UNIFORM_NAMES);
+
+        // Lookups of known names, the path taken by every setUniform call
+        {
+            gfx::ShaderProgram program(1);
+            for (const char* name : UNIFORM_NAMES) {
+                program.getUniformLocation(name);
+            }
+
+            const double ns = measureNanoseconds(options, 4096, [&](uint32_t i) {
+                return static_cast<uint64_t>(program.getUniformLocation(UNIFORM_NAMES[i % UNIFORM_COUNT]));
+            });
+            report.add("uniform_location_lookup", ns, "ns", false);
+
+            const double hashedNs = measureNanoseconds(options, 4096, [&](uint32_t i) {
+                return static_cast<uint64_t>(program.getUniformLocation(HASHED_UNIFORM_NAMES[i % UNIFORM_COUNT]));
+            });
+            report.add("uniform_location_lookup_ct_hash", hashedNs, "ns", false);
+        }
+
+        // Program creation reflects all uniforms up front, so this is the link time cost per uniform
+        const double ns = measureNanoseconds(options, 64, [&](uint32_t) {
+            gfx::ShaderProgram program(1);
+            uint64_t sum = 0;
+            for (const char* name : UNIFORM_NAMES) {
+                sum += program.getUniformLocation(name);
+            }
+            return sum;
+        });
+        report.add("uniform_reflection_and_lookup", ns / UNIFORM_COUNT, "ns", false);
+    }
+
+    // Uploads go to a stub, so this is the cost of glass around the driver call
+    static void benchmarkUniformShadowing(BenchReport& report, const CpuBenchOptions& options) {
+        using namespace glass::hash::literals;
+        setStubProgramUniforms(UNIFORM_NAMES);
+        gfx::ShaderProgram program(1);
+
+        const double redundantNs = measureNanoseconds(options, 4096, [&](uint32_t) {
+            gfx::setUniform(&program, "uLightColor"_hash, glm::vec4(1.0f));
+            return uint64_t(1);
+        });
+        report.add("set_uniform_redundant", redundantNs, "ns", false);
+
+        const double changingNs = measureNanoseconds(options, 4096, [&](uint32_t i) {
+            gfx::setUniform(&program, "uLightColor"_hash, glm::vec4(static_cast<float>(i)));
+            return uint64_t(1);
+        });
+        report.add("set_uniform_changing", changingNs, "ns", false);
+    }
+
+    static void benchmarkHash(BenchReport& report, const CpuBenchOptions& options) {
+        for (const uint32_t length : { 8u, 32u, 256u }) {
+            std::string text(length, 'a');
+            for (uint32_t i = 0; i < length; ++i) {
+                text[i] = static_cast<char>('a' + i % 26);
+            }
+
+            const double ns = measureNanoseconds(options, 4096, [&](uint32_t i) {
+                // Vary the first character so the hash can't be hoisted out of the loop
+                text[0] = static_cast<char>('a' + (i & 15));
+                return glass::hash::hash64(text.data(), text.size());
+            });
+            report.add(std::format("hash64_runtime_{}", length), ns, "ns", false);
+        }
+    }
+
+    static void benchmarkInputLayout(BenchReport& report, const CpuBenchOptions& options) {
+        const double ns = measureNanoseconds(options, 1024, [](uint32_t) {
+            gfx::BufferInputLayout layout{};
+            layout.add(gfx::EVT_Float, 3).add(gfx::EVT_Float, 3).add(gfx::EVT_Float, 2).add(gfx::EVT_Float, 4, false, gfx::EBDR_PerInstance);
+            return static_cast<uint64_t>(layout.getElements().size());
+        });
+        report.add("buffer_input_layout_4_elements", ns, "ns", false);
+    }
+
+    struct EventCounter {
+        uint64_t Count{};
+
+        void onResize(const gp::WindowResizeEvent& event) { Count += event.NewSize.Width; }
+        void onMouseMove(const gp::MouseMoveEvent& event) { Count += static_cast<uint64_t>(event.X); }
+        void onKeyPress(const gp::KeyPressEvent&) { ++Count; }
+        void onKeyRelease(const gp::KeyReleaseEvent&) { ++Count; }
+    };
+
+    static void benchmarkEventDispatch(BenchReport& report, const CpuBenchOptions& options) {
+        gp::MouseMoveEvent mouseMove{};
+        mouseMove.Type = gp::MouseMoveEvent::getStaticType();
+        mouseMove.X = 1.0;
+
+        gp::WindowResizeEvent resize{};
+        resize.Type = gp::WindowResizeEvent::getStaticType();
+        resize.NewSize = { 2, 2 };
+
+        const gp::WindowEvent* events[] = { &mouseMove, &resize };
+        EventCounter counter{};
+
+        // A typical callback tries every handled type on each event
+        const double ns = measureNanoseconds(options, 4096, [&](uint32_t i) {
+            gp::EventDispatcher dispatcher(*events[i & 1]);
+            dispatcher.dispatch(&counter, &EventCounter::onResize);
+            dispatcher.dispatch(&counter, &EventCounter::onMouseMove);
+            dispatcher.dispatch(&counter, &EventCounter::onKeyPress);
+            dispatcher.dispatch(&counter, &EventCounter::onKeyRelease);
+            return counter.Count;
+        });
+        report.add("event_dispatch_4_handlers", ns, "ns", false);
+    }
+
+    static void benchmarkHandleDecoding(BenchReport& report, const CpuBenchOptions& options) {
+        static constexpr uint32_t HANDLE_COUNT = 1024;
+        std::vector<gfx::ResourceID> textures(HANDLE_COUNT);
+        std::vector<gfx::ResourceID> buffers(HANDLE_COUNT);
+        for (uint32_t i = 0; i < HANDLE_COUNT; ++i) {
+            gfx::TextureHandle texture(gfx::ResourceID::Null);
+            texture.Type = gfx::ETT_Texture2D;
+            texture.Format = gfx::EPF_RGBA8;
+            texture.TextureID = i + 1;
+            textures[i] = static_cast<gfx::ResourceID>(texture.Id);
+
+            gfx::BufferHandle buffer(gfx::ResourceID::Null);
+            buffer.VAOID = static_cast<uint16_t>(i);
+            buffer.BufferType = gfx::EBT_Vertex;
+            buffer.BufferID = i + 1;
+            buffers[i] = static_cast<gfx::ResourceID>(buffer.ID);
+        }
+
+        const double textureNs = measureNanoseconds(options, HANDLE_COUNT, [&](uint32_t i) {
+            const gfx::ResourceID texture = textures[i % HANDLE_COUNT];
+            return static_cast<uint64_t>(gfx::getTextureID(texture)) + gfx::getTextureType(texture) + gfx::getTexturePixelFormat(texture);
+        });
+        report.add("texture_handle_decode", textureNs, "ns", false);
+
+        const double bufferNs = measureNanoseconds(options, HANDLE_COUNT, [&](uint32_t i) {
+            const gfx::ResourceID buffer = buffers[i % HANDLE_COUNT];
+            return static_cast<uint64_t>(gfx::getBufferID(buffer)) + gfx::getBufferType(buffer) + gfx::getVAOId(buffer);
+        });
+        report.add("buffer_handle_decode", bufferNs, "ns", false);
+    }
+
+    static void benchmarkFrameBufferRegistry(BenchReport& report, const CpuBenchOptions& options) {
+        // Framebuffers without attachments only touch the stubbed framebuffer entry points
+        const gfx::FrameBufferSpec spec{};
+
+        for (const uint32_t registered : { 1u, 64u, 1024u }) {
+            std::vector<gfx::FrameBuffer*> frameBuffers;
+            for (uint32_t i = 0; i < registered; ++i) {
+                frameBuffers.push_back(gfx::createFrameBuffer(spec));
+            }
+
+            // The newest framebuffer is the last one the search reaches
+            const double ns = measureNanoseconds(options, 256, [&](uint32_t) {
+                gfx::destroyFrameBuffer(frameBuffers.back());
+                frameBuffers.back() = gfx::createFrameBuffer(spec);
+                return static_cast<uint64_t>(frameBuffers.back()->getId());
+            });
+            report.add(std::format("destroy_create_framebuffer_{}_registered", registered), ns, "ns", false);
+
+            for (gfx::FrameBuffer* fb : frameBuffers) {
+                gfx::destroyFrameBuffer(fb);
+            }
+        }
+    }
+
+    void runCpuBenchmarks(BenchReport& report, const CpuBenchOptions& options) {
+        benchmarkUniformLocations(report, options);
+        benchmarkUniformShadowing(report, options);
+        benchmarkHash(report, options);
+        benchmarkInputLayout(report, options);
+        benchmarkEventDispatch(report, options);
+        benchmarkHandleDecoding(report, options);
+        benchmarkFrameBufferRegistry(report, options);
+    }
+} // namespace bench
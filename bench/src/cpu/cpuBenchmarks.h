@@ -0,0 +1,13 @@
+#pragma once
+
+#include "benchReport.h"
+
+namespace bench {
+    struct CpuBenchOptions {
+        /** Minimum time every benchmark runs for */
+        double MinSeconds{ 0.25 };
+    };
+
+    /** Needs installGLStubs, the benchmarks call into the GL paths of glass */
+    void runCpuBenchmarks(BenchReport& report, const CpuBenchOptions& options);
+} // namespace bench
@@ -0,0 +1,104 @@
+#include "glStubs.h"
+#include "glad/glad.h"
+#include "algorithm"
+#include "cstring"
+
+namespace bench {
+    static GLuint GNextObjectID = 1;
+    static std::span<const char* const> GProgramUniforms{};
+
+    static GLenum APIENTRY stubGetError() {
+        return GL_NO_ERROR;
+    }
+
+    static GLint APIENTRY stubGetUniformLocation(GLuint, const GLchar* name) {
+        return static_cast<GLint>(std::strlen(name));
+    }
+
+    // Programs have no uniform blocks
+    static void APIENTRY stubGetProgramiv(GLuint, GLenum, GLint* params) {
+        *params = 0;
+    }
+
+    static void APIENTRY stubUniformBlockBinding(GLuint, GLuint, GLuint) {}
+
+    static void APIENTRY stubDeleteProgram(GLuint) {}
+
+    static void APIENTRY stubProgramUniform4f(GLuint, GLint, GLfloat, GLfloat, GLfloat, GLfloat) {}
+
+    static void APIENTRY stubGetProgramInterfaceiv(GLuint, GLenum programInterface, GLenum name, GLint* params) {
+        const bool isUniform = programInterface == GL_UNIFORM;
+        if (name == GL_ACTIVE_RESOURCES) {
+            *params = isUniform ? static_cast<GLint>(GProgramUniforms.size()) : 0;
+        } else if (name == GL_MAX_NAME_LENGTH) {
+            size_t length = 0;
+            for (const char* uniform : GProgramUniforms) {
+                length = std::max(length, std::strlen(uniform) + 1);
+            }
+            *params = isUniform ? static_cast<GLint>(length) : 0;
+        }
+    }
+
+    static void APIENTRY stubGetProgramResourceName(GLuint, GLenum, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name) {
+        const size_t copied = std::min(std::strlen(GProgramUniforms[index]), static_cast<size_t>(bufSize - 1));
+        std::memcpy(name, GProgramUniforms[index], copied);
+        name[copied] = '\0';
+        *length = static_cast<GLsizei>(copied);
+    }
+
+    // Uniforms are vec4s of the default block, located at their index
+    static void APIENTRY stubGetProgramResourceiv(GLuint, GLenum, GLuint index, GLsizei propCount, const GLenum* props, GLsizei, GLsizei*, GLint* params) {
+        for (GLsizei i = 0; i < propCount; ++i) {
+            switch (props[i]) {
+                case GL_TYPE:
+                    params[i] = GL_FLOAT_VEC4;
+                    break;
+                case GL_LOCATION:
+                    params[i] = static_cast<GLint>(index);
+                    break;
+                case GL_ARRAY_SIZE:
+                    params[i] = 1;
+                    break;
+                default:
+                    params[i] = -1;
+                    break;
+            }
+        }
+    }
+
+    static void APIENTRY stubGenObjects(GLsizei count, GLuint* ids) {
+        for (GLsizei i = 0; i < count; ++i) {
+            ids[i] = GNextObjectID++;
+        }
+    }
+
+    static void APIENTRY stubDeleteObjects(GLsizei, const GLuint*) {}
+
+    static void APIENTRY stubBindFramebuffer(GLenum, GLuint) {}
+
+    static GLenum APIENTRY stubCheckFramebufferStatus(GLenum) {
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    void installGLStubs() {
+        glad_glGetError = stubGetError;
+
+        glad_glGetUniformLocation = stubGetUniformLocation;
+        glad_glGetProgramiv = stubGetProgramiv;
+        glad_glUniformBlockBinding = stubUniformBlockBinding;
+        glad_glDeleteProgram = stubDeleteProgram;
+        glad_glProgramUniform4f = stubProgramUniform4f;
+        glad_glGetProgramInterfaceiv = stubGetProgramInterfaceiv;
+        glad_glGetProgramResourceName = stubGetProgramResourceName;
+        glad_glGetProgramResourceiv = stubGetProgramResourceiv;
+
+        glad_glGenFramebuffers = stubGenObjects;
+        glad_glDeleteFramebuffers = stubDeleteObjects;
+        glad_glBindFramebuffer = stubBindFramebuffer;
+        glad_glCheckFramebufferStatus = stubCheckFramebufferStatus;
+    }
+
+    void setStubProgramUniforms(std::span<const char* const> names) {
+        GProgramUniforms = names;
+    }
+} // namespace bench
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "span"
+
+namespace bench {
+    /**
+     * Point the glad entry points used by the CPU benchmarks at stubs that do no work.
+     * Functions returning values behave like a driver that accepts everything.
+     */
+    void installGLStubs();
+
+    /** Default block uniforms every stubbed program reports through the program interface queries. Names must outlive the stubs. */
+    void setStubProgramUniforms(std::span<const char* const> names);
+} // namespace bench
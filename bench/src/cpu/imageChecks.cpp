@@ -0,0 +1,226 @@
+#include "imageChecks.h"
+#include "glass/glass.h"
+#include "image/yuvKernels.h"
+#include "algorithm"
+#include "cmath"
+#include "format"
+#include "print"
+#include "vector"
+
+namespace gfx = glass::gfx;
+namespace image = glass::image;
+
+namespace bench {
+    // Odd size, so the partial blocks at the right and bottom edges are covered
+    static constexpr int32_t CHECK_IMAGE_WIDTH = 259;
+    static constexpr int32_t CHECK_IMAGE_HEIGHT = 131;
+
+    static constexpr image::EImageKernel SIMD_KERNELS[] = { image::EIK_SSE41, image::EIK_AVX2 };
+
+    static const char* getKernelName(image::EImageKernel kernel) {
+        switch (kernel) {
+            case image::EIK_Scalar: return "scalar";
+            case image::EIK_SSE41: return "sse41";
+            case image::EIK_AVX2: return "avx2";
+            default: return "auto";
+        }
+    }
+
+    /** Smooth gradients with a ripple on top, close to the content runtime generated textures have */
+    static std::vector<uint8_t> createCheckImage() {
+        std::vector<uint8_t> pixels(static_cast<size_t>(CHECK_IMAGE_WIDTH) * CHECK_IMAGE_HEIGHT * 4);
+        for (int32_t y = 0; y < CHECK_IMAGE_HEIGHT; ++y) {
+            for (int32_t x = 0; x < CHECK_IMAGE_WIDTH; ++x) {
+                const float ripple = 24.0f * std::sin(static_cast<float>(x) * 0.11f) * std::cos(static_cast<float>(y) * 0.07f);
+                uint8_t* pixel = &pixels[(static_cast<size_t>(y) * CHECK_IMAGE_WIDTH + x) * 4];
+                pixel[0] = static_cast<uint8_t>(std::clamp(x * 255.0f / CHECK_IMAGE_WIDTH + ripple, 0.0f, 255.0f));
+                pixel[1] = static_cast<uint8_t>(std::clamp(y * 255.0f / CHECK_IMAGE_HEIGHT - ripple, 0.0f, 255.0f));
+                pixel[2] = static_cast<uint8_t>(std::clamp((x + y) * 255.0f / (CHECK_IMAGE_WIDTH + CHECK_IMAGE_HEIGHT) + ripple * 0.5f, 0.0f, 255.0f));
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }
+
+    /** PSNR over the first channelCount channels of two tightly packed RGBA8 images */
+    static double calculatePSNR(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, uint32_t channelCount) {
+        double squaredError = 0.0;
+        for (size_t i = 0; i < a.size(); i += 4) {
+            for (uint32_t c = 0; c < channelCount; ++c) {
+                const double difference = static_cast<double>(a[i + c]) - static_cast<double>(b[i + c]);
+                squaredError += difference * difference;
+            }
+        }
+
+        const double meanSquaredError = squaredError / static_cast<double>(a.size() / 4 * channelCount);
+        return meanSquaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : INFINITY;
+    }
+
+    static std::vector<uint8_t> compress(const image::ImageView& source, gfx::EPixelFormat format, image::EImageKernel kernel) {
+        image::setImageKernel(kernel);
+        std::vector<uint8_t> blocks(image::getCompressedImageSize(format, source.Width, source.Height));
+        image::compressImage(source, format, blocks);
+        return blocks;
+    }
+
+    static bool checkBlockEncoders(const std::vector<uint8_t>& pixels) {
+        struct EncoderCheck {
+            gfx::EPixelFormat Format;
+            const char* Name;
+            uint32_t ChannelCount;
+
+            /** Lower bound with some margin below the quality of the current encoder */
+            double MinPSNR;
+        };
+
+        static constexpr EncoderCheck ENCODER_CHECKS[] = {
+            { gfx::EPF_BC1, "bc1", 3, 40.0 },
+            { gfx::EPF_BC4, "bc4", 1, 51.0 },
+            { gfx::EPF_BC5, "bc5", 2, 51.0 },
+        };
+
+        const image::ImageView source{ pixels.data(), CHECK_IMAGE_WIDTH, CHECK_IMAGE_HEIGHT };
+        bool passed = true;
+        for (const EncoderCheck& check : ENCODER_CHECKS) {
+            const std::vector<uint8_t> reference = compress(source, check.Format, image::EIK_Scalar);
+
+            std::vector<uint8_t> decoded(pixels.size());
+            image::decompressImage(reference, check.Format, CHECK_IMAGE_WIDTH, CHECK_IMAGE_HEIGHT, decoded);
+            const double psnr = calculatePSNR(pixels, decoded, check.ChannelCount);
+            std::println("{:<40} {:>14.3f} dB", std::format("check_{}_psnr", check.Name), psnr);
+            if (psnr < check.MinPSNR) {
+                std::println("CHECK FAILED: {} PSNR is below {} dB", check.Name, check.MinPSNR);
+                passed = false;
+            }
+
+            // The SIMD kernels round with compares only, so their blocks have to match bit for bit
+            for (const image::EImageKernel kernel : SIMD_KERNELS) {
+                const std::vector<uint8_t> blocks = compress(source, check.Format, kernel);
+                if (image::getImageKernel() != kernel) {
+                    continue;
+                }
+
+                if (blocks != reference) {
+                    std::println("CHECK FAILED: {} blocks of the {} kernel differ from the scalar kernel", check.Name, getKernelName(kernel));
+                    passed = false;
+                }
+            }
+        }
+
+        return passed;
+    }
+
+    /** @return Largest difference of any byte between the chains */
+    static int32_t getMaxDifference(const image::MipChain& a, const image::MipChain& b) {
+        int32_t maxDifference = 0;
+        for (size_t i = 0; i < a.Pixels.size(); ++i) {
+            maxDifference = std::max(maxDifference, std::abs(static_cast<int32_t>(a.Pixels[i]) - static_cast<int32_t>(b.Pixels[i])));
+        }
+        return maxDifference;
+    }
+
+    static bool checkMipFilters(const std::vector<uint8_t>& pixels) {
+        const image::ImageView source{ pixels.data(), CHECK_IMAGE_WIDTH, CHECK_IMAGE_HEIGHT };
+        bool passed = true;
+        for (const image::EMipFilter filter : { image::EMF_Box, image::EMF_Kaiser }) {
+            for (const bool srgb : { false, true }) {
+                const char* name = filter == image::EMF_Box ? (srgb ? "box_srgb" : "box") : (srgb ? "kaiser_srgb" : "kaiser");
+
+                image::setImageKernel(image::EIK_Scalar);
+                const image::MipChain reference = image::generateMipChain(source, { filter, srgb });
+
+                // The AVX2 Kaiser kernel uses FMA, which may round the last bit differently
+                const int32_t tolerance = filter == image::EMF_Kaiser ? 1 : 0;
+                for (const image::EImageKernel kernel : SIMD_KERNELS) {
+                    image::setImageKernel(kernel);
+                    if (image::getImageKernel() != kernel) {
+                        continue;
+                    }
+
+                    const image::MipChain chain = image::generateMipChain(source, { filter, srgb });
+                    const int32_t difference = getMaxDifference(reference, chain);
+                    if (difference > tolerance) {
+                        std::println("CHECK FAILED: {} mip chain of the {} kernel differs from the scalar kernel by {}", name, getKernelName(kernel), difference);
+                        passed = false;
+                    }
+                }
+            }
+        }
+
+        // Half black, half white averages to a mid gray of 188 in sRGB. Alpha is linear and averages to 128.
+        std::vector<uint8_t> checkerboard(16 * 16 * 4);
+        for (int32_t y = 0; y < 16; ++y) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const uint8_t value = (x ^ y) & 1 ? 255 : 0;
+                std::fill_n(&checkerboard[(y * 16 + x) * 4], 4, value);
+            }
+        }
+
+        image::setImageKernel(image::EIK_Auto);
+        const image::MipChain chain = image::generateMipChain({ checkerboard.data(), 16, 16 }, { image::EMF_Box, true, 2 });
+        const uint8_t* level = static_cast<const uint8_t*>(chain.Levels[1]);
+        if (std::abs(level[0] - 188) > 1 || std::abs(level[3] - 128) > 1) {
+            std::println("CHECK FAILED: sRGB checkerboard filters to color {} and alpha {} instead of 188 and 128", level[0], level[3]);
+            passed = false;
+        }
+
+        return passed;
+    }
+
+    static std::vector<uint8_t> convertToYUV420(const uint8_t* firstRow, int64_t rowPitch, uint32_t width, uint32_t height, image::EImageKernel kernel) {
+        image::setImageKernel(kernel);
+        std::vector<uint8_t> planes(image::getYUV420ImageSize(static_cast<int32_t>(width), static_cast<int32_t>(height)));
+        image::convertToYUV420(firstRow, rowPitch, width, height, planes.data());
+        return planes;
+    }
+
+    static bool checkYUVConversion(const std::vector<uint8_t>& pixels) {
+        // Crops of the check image, so rows are padded. Odd sizes cover the repeated edge column and row.
+        static constexpr uint32_t SIZES[][2] = { { 259, 131 }, { 258, 130 }, { 37, 9 }, { 3, 1 }, { 1, 3 }, { 1, 1 } };
+        static constexpr int64_t ROW_PITCH = CHECK_IMAGE_WIDTH * 4;
+
+        bool passed = true;
+        for (const auto [width, height] : SIZES) {
+            const uint8_t* topRow = pixels.data();
+            const uint8_t* bottomRow = pixels.data() + ROW_PITCH * (height - 1);
+
+            // Walking the rows bottom up has to give the same planes as converting a flipped copy top down
+            std::vector<uint8_t> flipped(static_cast<size_t>(width) * height * 4);
+            for (uint32_t y = 0; y < height; ++y) {
+                std::copy_n(bottomRow - ROW_PITCH * y, width * 4, &flipped[static_cast<size_t>(width) * y * 4]);
+            }
+
+            const std::vector<uint8_t> topDown = convertToYUV420(topRow, ROW_PITCH, width, height, image::EIK_Scalar);
+            const std::vector<uint8_t> bottomUp = convertToYUV420(bottomRow, -ROW_PITCH, width, height, image::EIK_Scalar);
+            if (bottomUp != convertToYUV420(flipped.data(), width * 4, width, height, image::EIK_Scalar)) {
+                std::println("CHECK FAILED: {}x{} YUV conversion with a negative row pitch differs from a flipped image", width, height);
+                passed = false;
+            }
+
+            for (const image::EImageKernel kernel : SIMD_KERNELS) {
+                image::setImageKernel(kernel);
+                if (image::getImageKernel() != kernel) {
+                    continue;
+                }
+
+                if (convertToYUV420(topRow, ROW_PITCH, width, height, kernel) != topDown || convertToYUV420(bottomRow, -ROW_PITCH, width, height, kernel) != bottomUp) {
+                    std::println("CHECK FAILED: {}x{} YUV planes of the {} kernel differ from the scalar kernel", width, height, getKernelName(kernel));
+                    passed = false;
+                }
+            }
+        }
+
+        return passed;
+    }
+
+    bool runImageChecks() {
+        const std::vector<uint8_t> pixels = createCheckImage();
+
+        bool passed = checkBlockEncoders(pixels);
+        passed &= checkMipFilters(pixels);
+        passed &= checkYUVConversion(pixels);
+
+        image::setImageKernel(image::EIK_Auto);
+        return passed;
+    }
+} // namespace bench
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace bench {
+    /**
+     * Check the output of the CPU image kernels, which must hold on every machine the benchmarks run on.
+     * Every supported SIMD kernel is compared against the scalar one. Failures are printed.
+     * @return False if any check failed
+     */
+    bool runImageChecks();
+} // namespace bench
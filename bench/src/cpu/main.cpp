@@ -0,0 +1,28 @@
+#include "benchReport.h"
+#include "cpuBenchmarks.h"
+#include "glStubs.h"
+#include "imageChecks.h"
+
+// Measures the per call overhead of glass itself. No context is created, the GL entry points are stubs.
+int main(int argc, char** argv) {
+    bench::BenchArgs args{};
+    if (!bench::parseBenchArgs(argc, argv, args)) {
+        return 2;
+    }
+
+    bench::CpuBenchOptions options{};
+    if (args.MinSeconds > 0.0) {
+        options.MinSeconds = args.MinSeconds;
+    }
+
+    // Timings of kernels with wrong output mean nothing, so failed checks fail the run
+    const bool checksPassed = bench::runImageChecks();
+
+    bench::installGLStubs();
+
+    bench::BenchReport report{};
+    bench::runCpuBenchmarks(report, options);
+
+    const int result = bench::finishBenchReport(report, args);
+    return checksPassed ? result : 1;
+}
@@ -0,0 +1,271 @@
+#include "gpuBenchmarks.h"
+#include "glass/glass.h"
+#include "chrono"
+#include "filesystem"
+#include "format"
+#include "fstream"
+
+namespace gfx = glass::gfx;
+
+namespace bench {
+    static constexpr int32_t TARGET_SIZE = 256;
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Run batches until MinSeconds passed. The batch returns the amount of work it did (draws, bytes, ...).
+     * sync runs after every batch, so the GPU work is included in the time.
+     */
+    template <typename Batch, typename Sync>
+    static double measureRate(const BenchOptions& options, Batch&& batch, Sync&& sync) {
+        // Warm up driver caches and lazy allocations
+        batch();
+        sync();
+
+        double work = 0.0;
+        const Clock::time_point start = Clock::now();
+        std::chrono::duration<double> elapsed{};
+        do {
+            work += batch();
+            sync();
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < options.MinSeconds);
+
+        return work / elapsed.count();
+    }
+
+    // Reading a pixel back waits for every command before it
+    static void waitForGpu(gfx::FrameBuffer* target) {
+        uint8_t pixel[4]{};
+        gfx::setFrameBuffer(target, false);
+        gfx::readFramebufferColorAttachmentPixels(target, 0, 0, 0, 1, 1, pixel);
+    }
+
+    static gfx::Shader* writeShader(const BenchOptions& options, const std::string& name, const std::string& source, gfx::EShaderType type) {
+        const std::filesystem::path path = std::filesystem::path(options.ShaderDirectory) / name;
+        std::ofstream(path) << source;
+        return gfx::getOrCreateShader(path.string(), type);
+    }
+
+    static std::string getVertexSource(float scale) {
+        return std::format(
+            "#version 430 core\n"
+            "layout(location = 0) in vec2 aPosition;\n"
+            "layout(location = 1) in vec2 aUV;\n"
+            "out vec2 vUV;\n"
+            "void main() {{ vUV = aUV; gl_Position = vec4(aPosition * {:.3f}, 0.0, 1.0); }}\n",
+            scale);
+    }
+
+    static constexpr const char* FRAGMENT_SOURCE =
+        "#version 430 core\n"
+        "in vec2 vUV;\n"
+        "out vec4 oColor;\n"
+        "uniform sampler2D uTexture;\n"
+        "void main() { oColor = texture(uTexture, vUV); }\n";
+
+    struct Vertex {
+        glm::vec2 Position;
+        glm::vec2 UV;
+    };
+
+    static gfx::ResourceID createQuad(float offset) {
+        const Vertex vertices[] = {
+            { { -0.1f + offset, -0.1f }, { 0.0f, 0.0f } },
+            { { +0.1f + offset, -0.1f }, { 1.0f, 0.0f } },
+            { { +0.1f + offset, +0.1f }, { 1.0f, 1.0f } },
+            { { -0.1f + offset, +0.1f }, { 0.0f, 1.0f } },
+        };
+
+        static gfx::BufferInputLayout layout{};
+        if (layout.getElements().empty()) {
+            layout.add(gfx::EVT_Float, 2).add(gfx::EVT_Float, 2);
+        }
+
+        return gfx::createStaticVertexBuffer(sizeof(vertices), vertices, &layout);
+    }
+
+    static gfx::ResourceID createSolidTexture(uint32_t color) {
+        std::vector<uint32_t> pixels(64 * 64, color);
+        gfx::TextureSpec spec{};
+        spec.Width = 64;
+        spec.Height = 64;
+        spec.InitialData = pixels.data();
+        return gfx::createTexture(spec);
+    }
+
+    enum class EStateChurn {
+        None,
+        Texture,
+        Program,
+        VertexBuffer,
+    };
+
+    static void benchmarkDraws(BenchReport& report, const BenchOptions& options, gfx::FrameBuffer* target) {
+        gfx::ShaderProgram* programs[2]{};
+        for (int32_t i = 0; i < 2; ++i) {
+            programs[i] = gfx::getOrCreateShaderProgram({
+                .VertexShader = writeShader(options, std::format("draw{}.vert", i), getVertexSource(1.0f + i * 0.5f), gfx::EST_VertexShader),
+                .FragmentShader = writeShader(options, "draw.frag", FRAGMENT_SOURCE, gfx::EST_FragmentShader),
+            });
+        }
+
+        const gfx::ResourceID quads[2] = { createQuad(-0.5f), createQuad(0.5f) };
+        const gfx::ResourceID textures[2] = { createSolidTexture(0xff0000ff), createSolidTexture(0xff00ff00) };
+        uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+        const gfx::ResourceID indexBuffer = gfx::createStaticElementBuffer(indices);
+
+        static constexpr uint32_t DRAWS_PER_BATCH = 2000;
+        const std::pair<EStateChurn, const char*> cases[] = {
+            { EStateChurn::None, "draw_elements_no_churn" },
+            { EStateChurn::Texture, "draw_elements_texture_churn" },
+            { EStateChurn::Program, "draw_elements_program_churn" },
+            { EStateChurn::VertexBuffer, "draw_elements_vertex_buffer_churn" },
+        };
+
+        for (const auto& [churn, name] : cases) {
+            const double rate = measureRate(
+                options,
+                [&, churn] {
+                    gfx::setFrameBuffer(target);
+                    gfx::bindShaderProgram(programs[0]);
+                    gfx::setUniformTexture(programs[0], "uTexture", textures[0]);
+                    gfx::bindVertexBuffer(quads[0]);
+                    gfx::bindElementBuffer(indexBuffer);
+
+                    for (uint32_t draw = 0; draw < DRAWS_PER_BATCH; ++draw) {
+                        const uint32_t index = draw & 1;
+                        switch (churn) {
+                            case EStateChurn::None:
+                                break;
+                            case EStateChurn::Texture:
+                                gfx::setUniformTexture(programs[0], "uTexture", textures[index]);
+                                break;
+                            case EStateChurn::Program:
+                                gfx::bindShaderProgram(programs[index]);
+                                gfx::setUniformTexture(programs[index], "uTexture", textures[0]);
+                                break;
+                            case EStateChurn::VertexBuffer:
+                                // The element buffer binding is part of the vertex array state
+                                gfx::bindVertexBuffer(quads[index]);
+                                gfx::bindElementBuffer(indexBuffer);
+                                break;
+                        }
+
+                        gfx::drawElements(gfx::EPT_Triangles, 6);
+                    }
+                    return static_cast<double>(DRAWS_PER_BATCH);
+                },
+                [target] { waitForGpu(target); });
+
+            report.add(name, rate, "draws/s", true);
+        }
+
+        for (int32_t i = 0; i < 2; ++i) {
+            gfx::destroyBuffer(quads[i]);
+            gfx::destroyTexture(textures[i]);
+        }
+        gfx::destroyBuffer(indexBuffer);
+    }
+
+    static void benchmarkUploads(BenchReport& report, const BenchOptions& options, gfx::FrameBuffer* target) {
+        static constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+        for (const uint64_t size : { uint64_t(64 * 1024), uint64_t(4 * 1024 * 1024) }) {
+            std::vector<uint8_t> data(size, 0x5a);
+            gfx::BufferSpec spec{};
+            spec.SizeInBytes = size;
+            spec.BufferType = gfx::EBT_Storage;
+            spec.Mutability = gfx::EBM_Dynamic;
+            const gfx::ResourceID buffer = gfx::createBuffer(spec);
+
+            const double rate = measureRate(
+                options,
+                [&] {
+                    for (int32_t i = 0; i < 16; ++i) {
+                        gfx::writeBufferData(buffer, data.data(), size);
+                    }
+                    return 16.0 * size / MEGABYTE;
+                },
+                [target] { waitForGpu(target); });
+
+            report.add(std::format("write_buffer_data_{}k", size / 1024), rate, "MB/s", true);
+            gfx::destroyBuffer(buffer);
+        }
+
+        static constexpr int32_t TEXTURE_SIZE = 1024;
+        std::vector<uint32_t> pixels(TEXTURE_SIZE * TEXTURE_SIZE, 0xff336699);
+        const double rate = measureRate(
+            options,
+            [&] {
+                gfx::TextureSpec spec{};
+                spec.Width = TEXTURE_SIZE;
+                spec.Height = TEXTURE_SIZE;
+                spec.GenerateMipmaps = false;
+                spec.InitialData = pixels.data();
+                gfx::destroyTexture(gfx::createTexture(spec));
+                return pixels.size() * sizeof(uint32_t) / MEGABYTE;
+            },
+            [target] { waitForGpu(target); });
+
+        report.add("create_texture_1024_rgba8", rate, "MB/s", true);
+    }
+
+    static void benchmarkFrameBufferResize(BenchReport& report, const BenchOptions& options, gfx::FrameBuffer* target) {
+        gfx::FrameBufferSpec spec{};
+        spec.Width = 640;
+        spec.Height = 480;
+        spec.ColorAttachmentFormats[0] = gfx::EPF_RGBA8;
+        spec.DepthAttachmentFormat = gfx::EPF_DepthStencil;
+        gfx::FrameBuffer* fb = gfx::createFrameBuffer(spec);
+
+        uint32_t resizes = 0;
+        const double rate = measureRate(
+            options,
+            [&] {
+                for (int32_t i = 0; i < 8; ++i, ++resizes) {
+                    gfx::resizeFrameBuffer(fb, resizes & 1 ? 640 : 1280, resizes & 1 ? 480 : 720);
+                }
+                return 8.0;
+            },
+            [target] { waitForGpu(target); });
+
+        report.add("framebuffer_resize", 1000.0 / rate, "ms", false);
+        gfx::destroyFrameBuffer(fb);
+    }
+
+    static void benchmarkProgramCreation(BenchReport& report, const BenchOptions& options, gfx::FrameBuffer* target) {
+        // Shaders and programs are cached by path, so every program gets a vertex shader file of its own
+        uint32_t programs = 0;
+        gfx::Shader* fragmentShader = writeShader(options, "program.frag", FRAGMENT_SOURCE, gfx::EST_FragmentShader);
+        const double rate = measureRate(
+            options,
+            [&] {
+                gfx::Shader* vertexShader = writeShader(options, std::format("program{}.vert", programs), getVertexSource(1.0f + programs * 0.001f), gfx::EST_VertexShader);
+                gfx::ShaderProgram* program = gfx::getOrCreateShaderProgram({ .VertexShader = vertexShader, .FragmentShader = fragmentShader });
+                gfx::bindShaderProgram(program);
+                ++programs;
+                return 1.0;
+            },
+            [target] { waitForGpu(target); });
+
+        report.add("shader_program_creation", 1000.0 / rate, "ms", false);
+    }
+
+    void runGpuBenchmarks(BenchReport& report, const BenchOptions& options) {
+        std::filesystem::create_directories(options.ShaderDirectory);
+
+        gfx::FrameBufferSpec targetSpec{};
+        targetSpec.Width = TARGET_SIZE;
+        targetSpec.Height = TARGET_SIZE;
+        targetSpec.ColorAttachmentFormats[0] = gfx::EPF_RGBA8;
+        gfx::FrameBuffer* target = gfx::createFrameBuffer(targetSpec);
+
+        benchmarkDraws(report, options, target);
+        benchmarkUploads(report, options, target);
+        benchmarkFrameBufferResize(report, options, target);
+        benchmarkProgramCreation(report, options, target);
+
+        gfx::destroyFrameBuffer(target);
+    }
+} // namespace bench
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "benchReport.h"
+
+namespace bench {
+    struct BenchOptions {
+        /** Minimum time every benchmark runs for */
+        double MinSeconds{ 0.5 };
+
+        /** Directory for the generated shader files */
+        std::string ShaderDirectory;
+    };
+
+    /** Needs a current glass context */
+    void runGpuBenchmarks(BenchReport& report, const BenchOptions& options);
+} // namespace bench
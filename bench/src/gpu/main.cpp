@@ -0,0 +1,44 @@
+#include "glass/glass.h"
+#include "benchReport.h"
+#include "gpuBenchmarks.h"
+#include "filesystem"
+#include "print"
+
+namespace gp = glass::platform;
+namespace gfx = glass::gfx;
+
+// The window is never shown, so the benchmarks run on CI machines with a virtual display (e.g. Xvfb with llvmpipe)
+int main(int argc, char** argv) {
+    bench::BenchArgs args{};
+    if (!bench::parseBenchArgs(argc, argv, args)) {
+        return 2;
+    }
+
+    bench::BenchOptions options{};
+    options.ShaderDirectory = (std::filesystem::temp_directory_path() / "glass_bench").string();
+    if (args.MinSeconds > 0.0) {
+        options.MinSeconds = args.MinSeconds;
+    }
+
+    if (!gp::init()) {
+        std::println("Failed to initialize glass");
+        return 1;
+    }
+
+    gp::WindowSpec spec{};
+    spec.Size = { 256, 256 };
+    spec.Title = "glass_bench";
+    spec.Visible = false;
+    spec.Focused = false;
+    gp::Window* window = gp::createWindow(spec);
+    gfx::Context* context = gfx::createContext({ window, false });
+
+    bench::BenchReport report{};
+    bench::runGpuBenchmarks(report, options);
+
+    gfx::destroyContext(context);
+    gp::destroyWindow(window);
+    gp::shutdown();
+
+    return bench::finishBenchReport(report, args);
+}
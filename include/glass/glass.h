@@ -6,9 +6,13 @@
 #include "variant"
 #include "format"
 #include "functional"
+#include "vector"
+#include "span"
+#include "future"
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
+#include "glass/hashHelpers.h"
 
 #ifdef GLASS_SHARED
     #ifdef _MSC_VER
@@ -779,6 +783,9 @@ namespace glass {
 
             /** The buffer is a storage buffer */
             EBT_Storage,
+
+            /** The buffer holds indirect draw commands */
+            EBT_Indirect,
         };
 
         /** Value type */
@@ -790,6 +797,11 @@ namespace glass {
 
         enum EBufferDataRate {
             EBDR_PerVertex,
+
+            /**
+             * The element advances once per instance. Per instance elements are tightly packed in a separate buffer
+             * attached with bindInstanceBuffer, in the order they were added to the layout.
+             */
             EBDR_PerInstance,
         };
 
@@ -950,6 +962,16 @@ namespace glass {
         /** Bind element buffer to the pipeline */
         GLASS_API void bindElementBuffer(ResourceID buffer);
 
+        /**
+         * @brief Attach the buffer holding the per instance elements (EBDR_PerInstance) of a vertex buffer's input layout. Binds the vertex buffer.
+         * Instanced draws offset the instance data by their base instance, so instances of several meshes can share one buffer.
+         * @param vertexBuffer The vertex buffer whose input layout has per instance elements
+         * @param instanceBuffer Buffer with the per instance data. Any buffer type can be attached.
+         * @param strideInBytes Size of the data of one instance
+         * @param offset Offset in bytes of the first instance in the buffer
+         */
+        GLASS_API void bindInstanceBuffer(ResourceID vertexBuffer, ResourceID instanceBuffer, uint64_t strideInBytes, uint64_t offset = 0);
+
         /** Type of texture (dimensions) */
         enum ETextureType : uint16_t {
             /** 1D texture (x only) */
@@ -963,6 +985,9 @@ namespace glass {
 
             /** Cube texture (made of 6 2D planes) */
             ETT_TextureCube,
+
+            /** Array of 2D textures with the same size and format (xy + layer). TextureSpec::Depth is the layer count. */
+            ETT_Texture2DArray,
         };
 
         /** Pixel format of the texture */
@@ -984,6 +1009,30 @@ namespace glass {
 
             /** D24S8 bit format for handling depth stencil components */
             EPF_DepthStencil,
+
+            /** Block compressed RGB with 1-bit alpha, 8 bytes per 4x4 block (DXT1) */
+            EPF_BC1,
+
+            /** Block compressed RGBA, 16 bytes per 4x4 block (DXT5) */
+            EPF_BC3,
+
+            /** Block compressed single channel, 8 bytes per 4x4 block (RGTC1) */
+            EPF_BC4,
+
+            /** Block compressed two channels, 16 bytes per 4x4 block (RGTC2). Suited for normal maps. */
+            EPF_BC5,
+
+            /** High quality block compressed RGBA, 16 bytes per 4x4 block (BPTC) */
+            EPF_BC7,
+
+            /** ETC2 compressed RGB, 8 bytes per 4x4 block */
+            EPF_ETC2_RGB8,
+
+            /** ETC2 compressed RGBA with EAC alpha, 16 bytes per 4x4 block */
+            EPF_ETC2_RGBA8,
+
+            /** RGBA 32 bit format with sRGB encoded color. Sampling and blending happen in linear space. */
+            EPF_SRGBA8,
         };
 
         /** Texture filtering mode */
@@ -1010,13 +1059,49 @@ namespace glass {
             ETWM_ClampToBorder,
         };
 
+        /** How samples from neighbouring mip levels are combined */
+        enum ETextureMipFilter {
+            /** Only the base level is sampled */
+            ETMF_None,
+
+            /** Sample the closest mip level */
+            ETMF_Nearest,
+
+            /** Blend between the two closest mip levels (trilinear filtering with ETF_Linear) */
+            ETMF_Linear,
+        };
+
+        /** Comparison function for depth comparison samplers */
+        enum ECompareFunc {
+            ECF_Never,
+            ECF_Less,
+            ECF_Equal,
+            ECF_LessEqual,
+            ECF_Greater,
+            ECF_NotEqual,
+            ECF_GreaterEqual,
+            ECF_Always,
+        };
+
         /** Specification for texture sampler */
         struct SamplerSpec {
             ETextureFilter MinFilter{ ETF_Linear };
             ETextureFilter MagFilter{ ETF_Linear };
+            ETextureMipFilter MipFilter{ ETMF_None };
             ETextureWrapMode WrapModeS{ ETWM_ClampToEdge };
             ETextureWrapMode WrapModeT{ ETWM_ClampToEdge };
             ETextureWrapMode WrapModeU{ ETWM_ClampToEdge };
+
+            /** Anisotropic filtering level. Values above 1 are clamped to the maximum supported by the driver. */
+            float MaxAnisotropy{ 1.0f };
+
+            float LodBias{ 0.0f };
+            float MinLod{ -1000.0f };
+            float MaxLod{ 1000.0f };
+
+            /** Compare sampled depth against the reference coordinate (sampler2DShadow in GLSL) */
+            bool CompareEnabled{ false };
+            ECompareFunc CompareFunc{ ECF_LessEqual };
         };
 
         /** Specification for texture creation */
@@ -1025,11 +1110,23 @@ namespace glass {
             EPixelFormat Format{ EPF_RGBA8 };
             int32_t Width{ 1 };
             int32_t Height{ 1 };
+
+            /** Depth of 3D textures or the number of layers of array textures */
             int32_t Depth{ 1 };
             bool GenerateMipmaps{ true };
             SamplerSpec Sampler{};
 
             const void* InitialData{};
+
+            /**
+             * Optional tightly packed pixels of every mip level, finest (level 0) first.
+             * If set, the texture gets immutable storage for MipLevels levels, InitialData and GenerateMipmaps are ignored.
+             * Compressed formats store whole 4x4 blocks per level.
+             */
+            const void* const* MipData{};
+
+            /** Number of levels in MipData. 0 means the full chain. */
+            uint32_t MipLevels{ 0 };
         };
 
         GLASS_API ResourceID createTexture(const TextureSpec& spec);
@@ -1038,6 +1135,116 @@ namespace glass {
 
         GLASS_API void destroyTexture(ResourceID texture);
 
+        /**
+         * @brief Get a sampler object for the spec. Equal specs share one sampler.
+         * Samplers override the sampling parameters a texture was created with, so one texture can be sampled in several ways.
+         * They are owned by glass and released on shutdown.
+         */
+        GLASS_API ResourceID getOrCreateSampler(const SamplerSpec& spec);
+
+        GLASS_API uint32_t getOpenGLSamplerID(ResourceID sampler);
+
+        /** Bind a sampler to a texture unit. ResourceID::Null restores the parameters of the bound texture. */
+        GLASS_API void bindSampler(uint32_t unit, ResourceID sampler);
+
+        /** Whether the pixel format is block compressed (stored in 4x4 pixel blocks) */
+        GLASS_API bool isCompressedPixelFormat(EPixelFormat format);
+
+        /**
+         * @brief Load a 2D texture with its mip chain from a KTX2 or DDS file.
+         * The file is memory mapped and every level is uploaded straight from the mapping.
+         * Supports the block compressed formats of EPixelFormat as well as RGBA8, sRGB RGBA8 and RGB8. Supercompressed KTX2 files,
+         * arrays, cube maps and volume textures are not supported.
+         * @return Texture or ResourceID::Null if the file can't be read or its format is unsupported
+         */
+        GLASS_API ResourceID loadTextureFile(const char* path, const SamplerSpec& sampler = {});
+
+        /**
+         * @brief Update a region of an existing texture.
+         * @param texture The texture to update
+         * @param mipLevel Mip level to write to
+         * @param x, y, z Offset of the region in pixels (z is the depth offset of 3D textures or the first layer of array textures)
+         * @param width, height, depth Size of the region in pixels (depth is the layer count for array textures). Use 1 for unused dimensions.
+         * @param data Tightly packed pixels of the texture format. Compressed formats take whole 4x4 blocks and
+         *        need x and y aligned to the block size.
+         * @param async If true, the data is copied into a pixel unpack buffer from a ring and uploaded from it,
+         *        so the call returns without waiting for the transfer. The data can be freed right after the call.
+         *        The ring grows while uploads are in flight, up to the limit of setTextureUploadRingLimit.
+         */
+        GLASS_API void writeTextureData(ResourceID texture, uint32_t mipLevel, int32_t x, int32_t y, int32_t z, int32_t width, int32_t height, int32_t depth, const void* data, bool async = false);
+
+        /**
+         * @brief Maximum number of asynchronous texture uploads in flight, 64 by default.
+         * Past the limit an asynchronous upload waits for the GPU to finish the oldest one. Each upload buffer keeps the size
+         * of the largest upload it held, so a higher limit trades memory for fewer stalls.
+         */
+        GLASS_API void setTextureUploadRingLimit(uint32_t maxUploads);
+
+        /** Number of levels in a full mip chain of a texture with the given size */
+        static constexpr uint32_t getMipLevelCount(int32_t width, int32_t height = 1, int32_t depth = 1) {
+            int32_t size = width > height ? width : height;
+            size = size > depth ? size : depth;
+
+            uint32_t levels = 1;
+            while (size > 1) {
+                size >>= 1;
+                ++levels;
+            }
+            return levels;
+        }
+
+        /** Specification for a 2D texture whose mip levels are uploaded progressively, coarsest first */
+        struct StreamingTextureSpec {
+            EPixelFormat Format{ EPF_RGBA8 };
+            int32_t Width{ 1 };
+            int32_t Height{ 1 };
+
+            /** Number of mip levels of the texture. 0 means the full chain. */
+            uint32_t MipLevels{ 0 };
+
+            /**
+             * Tightly packed pixels of every mip level, finest (level 0) first.
+             * The array and the pixels must stay valid until the texture is fully resident or destroyed.
+             */
+            const void* const* MipData{};
+
+            /** Bytes uploaded by createStreamingTexture itself. The coarsest level is always uploaded. */
+            uint64_t InitialUploadBytes{ 64 * 1024 };
+
+            SamplerSpec Sampler{};
+        };
+
+        /**
+         * @brief Create a texture with immutable storage for its whole mip chain and upload only its coarsest levels.
+         * Finer levels are streamed in by updateTextureStreaming. Sampling is clamped to the finest resident level
+         * via GL_TEXTURE_BASE_LEVEL and GL_TEXTURE_MIN_LOD, so the texture can be used right away.
+         */
+        GLASS_API ResourceID createStreamingTexture(const StreamingTextureSpec& spec);
+
+        /**
+         * @brief Upload the next finer mip levels of streaming textures that have not reached their requested mip.
+         * Call once per frame. Levels are uploaded through the pixel unpack ring used by writeTextureData.
+         * @param byteBudget Maximum bytes uploaded by this call. A level larger than the whole budget is still uploaded
+         *        when nothing else was uploaded this call, so streaming can't stall.
+         * @return Number of bytes uploaded
+         */
+        GLASS_API uint64_t updateTextureStreaming(uint64_t byteBudget);
+
+        /**
+         * @brief Set the finest mip level a streaming texture should be made resident at. Defaults to 0.
+         * Requesting a coarser level than the resident one clamps sampling to it; memory is not released.
+         */
+        GLASS_API void setTextureRequestedMip(ResourceID texture, uint32_t mipLevel);
+
+        /** Finest mip level requested for a streaming texture. 0 for other textures. */
+        GLASS_API uint32_t getTextureRequestedMip(ResourceID texture);
+
+        /** Finest mip level of a streaming texture that is uploaded. 0 for other textures. */
+        GLASS_API uint32_t getTextureResidentMip(ResourceID texture);
+
+        /** Whether a streaming texture has every level down to its requested mip uploaded. Always true for other textures. */
+        GLASS_API bool isTextureStreamingComplete(ResourceID texture);
+
         /**
          * FRAMEBUFFERS
          */
@@ -1116,6 +1323,37 @@ namespace glass {
          */
         GLASS_API void readFramebufferColorAttachmentPixels(const FrameBuffer* fb, uint8_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* outData);
 
+        /** Handle of a framebuffer read started with readFramebufferAsync */
+        enum class ReadbackTicket : uint64_t {
+            Invalid = UINT64_MAX,
+        };
+
+        /** Number of asynchronous reads that can be in flight. Older tickets expire when newer reads reuse their buffer. */
+        static constexpr uint32_t MAX_PENDING_READBACKS = 4;
+
+        /**
+         * @brief Start reading pixels of a framebuffer attachment without waiting for the GPU.
+         * The pixels are copied into a pixel pack buffer from a ring and fenced. Poll the ticket with isReadbackReady
+         * and map it once it's done, usually a frame or two later.
+         * @return Ticket of the read. It stays valid until MAX_PENDING_READBACKS newer reads are started.
+         */
+        GLASS_API ReadbackTicket readFramebufferAsync(const FrameBuffer* fb, uint8_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+        /** Check without blocking whether the GPU finished the read. Expired tickets are never ready. */
+        GLASS_API bool isReadbackReady(ReadbackTicket ticket);
+
+        /** Size in bytes of the pixels of the read, 0 if the ticket expired */
+        GLASS_API uint64_t getReadbackSize(ReadbackTicket ticket);
+
+        /**
+         * @brief Map the pixels of the read, waiting for the GPU if the read isn't finished yet.
+         * Rows are tightly packed, bottom row first (like readFramebufferColorAttachmentPixels).
+         * Unmap before starting the next asynchronous read.
+         * @return Pointer to the pixels or nullptr if the ticket expired
+         */
+        GLASS_API const void* mapReadback(ReadbackTicket ticket);
+        GLASS_API void unmapReadback(ReadbackTicket ticket);
+
         /**
          * SHADER API
          */
@@ -1131,6 +1369,14 @@ namespace glass {
         class Shader;
         class ShaderProgram;
 
+        /** Macro defined right after the #version directive of a shader */
+        struct ShaderDefine {
+            std::string Name{};
+
+            /** Empty defines the macro without a value */
+            std::string Value{};
+        };
+
         struct ProgramSpec {
             Shader* VertexShader{};
             Shader* FragmentShader{};
@@ -1142,19 +1388,188 @@ namespace glass {
 
         /**
          * Get or create shader. If shader was already created with this path, a valid instance will be returned.
+         * While the program binary cache is enabled, compilation is deferred: a shader with source errors is still returned,
+         * and the errors are reported when getOrCreateShaderProgram fails for a program using it.
          */
         GLASS_API Shader* getOrCreateShader(const std::string& path, EShaderType type);
 
+        /**
+         * @brief Get or create a permutation of a shader. Shaders are keyed by the path and the define set, the order of the defines doesn't matter.
+         * #include "file" and #include <file> directives are resolved relative to the including file. Files are read once and shared by all permutations.
+         * @return nullptr if a file can't be opened or the shader fails to compile. Compile errors are only detected
+         *         by getOrCreateShaderProgram while the program binary cache is enabled (see getOrCreateShader).
+         */
+        GLASS_API Shader* getOrCreateShader(const std::string& path, EShaderType type, std::span<const ShaderDefine> defines);
+
         /**
          * Get or create shader program. If program already exists, it will be returned.
          */
         GLASS_API ShaderProgram* getOrCreateShaderProgram(const ProgramSpec& spec);
 
+        /**
+         * @brief Store linked program binaries in a directory and load them from there on later runs instead of compiling.
+         * Binaries are keyed by the sources of all stages and the driver vendor, renderer and version strings.
+         * Binaries of other drivers are removed, binaries the driver rejects fall back to compiling from source.
+         * Call after creating the context and before creating shaders: shaders created while the cache is enabled
+         * compile only when a program using them misses the cache, so source errors are reported by getOrCreateShaderProgram.
+         * @return false if the driver supports no program binary formats or the directory can't be created
+         */
+        GLASS_API bool enableProgramBinaryCache(const std::string& directory);
+        GLASS_API void disableProgramBinaryCache();
+
+        struct ProgramBinaryCacheStats {
+            /** Programs loaded from binaries */
+            uint32_t Hits{};
+
+            /** Programs without a stored binary */
+            uint32_t Misses{};
+
+            /** Stored binaries the driver refused to load */
+            uint32_t Rejected{};
+
+            /** Binaries written */
+            uint32_t Stores{};
+        };
+
+        GLASS_API ProgramBinaryCacheStats getProgramBinaryCacheStats();
+
+        /** Source file paths of program stages, empty paths leave the stage out */
+        struct ProgramSourceSpec {
+            std::string VertexShader{};
+            std::string FragmentShader{};
+            std::string ComputeShader{};
+            std::string GeometryShader{};
+            std::string TesellationControlShader{};
+            std::string TesellationEvaluationShader{};
+
+            /** Defines of every stage */
+            std::vector<ShaderDefine> Defines{};
+        };
+
+        class ShaderCompileBatch;
+
+        /**
+         * @brief Create a batch that builds many programs without waiting for each compilation.
+         * All compilations of a batch are issued before any link, and statuses are queried only once the work is done,
+         * so drivers can compile on their own threads. With KHR_parallel_shader_compile the thread count is left
+         * to the driver and poll checks completion without blocking, without it polling waits for the work.
+         * Batches and their futures belong to the thread owning the context.
+         */
+        GLASS_API ShaderCompileBatch* createShaderCompileBatch();
+
+        /** Finish the pending work of the batch and destroy it. Programs stay in the registry. */
+        GLASS_API void destroyShaderCompileBatch(ShaderCompileBatch* batch);
+
+        /**
+         * @brief Queue a program. Shaders and programs that already exist are reused.
+         * @return Future of the program, nullptr if it fails to compile or link. Becomes ready in poll or finish.
+         */
+        GLASS_API std::shared_future<ShaderProgram*> addShaderProgram(ShaderCompileBatch* batch, const ProgramSourceSpec& spec);
+
+        /** Issue compilation and linking of all queued programs. Programs found in the binary cache are ready immediately. */
+        GLASS_API void submitShaderCompileBatch(ShaderCompileBatch* batch);
+
+        /**
+         * @brief Resolve submitted programs whose linking finished. Submits queued programs first.
+         * @return true if no work of the batch is pending
+         */
+        GLASS_API bool pollShaderCompileBatch(ShaderCompileBatch* batch);
+
+        /** Wait for all programs of the batch. */
+        GLASS_API void finishShaderCompileBatch(ShaderCompileBatch* batch);
+
+        /** Whether the driver exposes KHR_parallel_shader_compile or ARB_parallel_shader_compile */
+        GLASS_API bool isParallelShaderCompileSupported();
+
         /**
          * Binds shader program to the pipeline.
          */
         GLASS_API void bindShaderProgram(const ShaderProgram* program);
 
+        /**
+         * @brief Get or create a program of a single shader linked with GL_PROGRAM_SEPARABLE, to be combined with other stages in a program pipeline.
+         * Set uniforms of the stage on this program. Separable vertex, geometry and tesellation stages must redeclare the gl_PerVertex outputs they write.
+         */
+        GLASS_API ShaderProgram* getOrCreateSeparableProgram(Shader* shader);
+
+        class ProgramPipeline;
+
+        /**
+         * @brief Get or create a program pipeline combining separable programs of the stages in the spec. Pipelines are cached by the set of stages.
+         * Each shader is linked once no matter how many pipelines use it, so N vertex and M fragment variants take N + M links instead of N * M.
+         * @return nullptr if the spec is invalid or a stage fails to link
+         */
+        GLASS_API ProgramPipeline* getOrCreateProgramPipeline(const ProgramSpec& spec);
+
+        /** Separable program of the stage for setting its uniforms, nullptr if the pipeline lacks the stage */
+        GLASS_API ShaderProgram* getProgramPipelineStage(const ProgramPipeline* pipeline, EShaderType type);
+
+        /** Binds program pipeline. Unbinds the program bound by bindShaderProgram, which would take precedence. */
+        GLASS_API void bindProgramPipeline(const ProgramPipeline* pipeline);
+
+        enum EShaderResourceType {
+            /** Uniform of the default block or member of a uniform block */
+            ESRT_Uniform,
+            ESRT_UniformBlock,
+            ESRT_StorageBlock,
+
+            /** Member of a shader storage block */
+            ESRT_BufferVariable,
+            ESRT_VertexInput,
+        };
+
+        /**
+         * Active resource of a linked program, reflected once at link time. Fields that don't apply to the resource type are -1.
+         * Arrays of basic types are listed once with the "[0]" suffix, like GL reports them.
+         */
+        struct ShaderResourceInfo {
+            std::string Name;
+            EShaderResourceType Type{};
+
+            /** GL type of uniforms, buffer variables and vertex inputs (e.g. GL_FLOAT_VEC4). 0 for blocks. */
+            uint32_t GLType{};
+
+            /** Location of default block uniforms and vertex inputs */
+            int32_t Location{ -1 };
+
+            /** Block members: index of the containing block. Blocks: their own index. */
+            int32_t BlockIndex{ -1 };
+
+            /** Byte offset of a block member */
+            int32_t Offset{ -1 };
+            int32_t ArraySize{ -1 };
+            int32_t ArrayStride{ -1 };
+            int32_t MatrixStride{ -1 };
+
+            /** Blocks: binding point and minimum buffer size in bytes */
+            int32_t Binding{ -1 };
+            int32_t DataSize{ -1 };
+        };
+
+        /**
+         * @brief Get all active resources of the program, sorted by type and name.
+         * Empty on contexts older than GL 4.3, which lack program interface queries.
+         */
+        GLASS_API std::span<const ShaderResourceInfo> getShaderProgramResources(const ShaderProgram* program);
+
+        /** @brief Find an active resource of the program. Returns nullptr if there is none. */
+        GLASS_API const ShaderResourceInfo* findShaderProgramResource(const ShaderProgram* program, EShaderResourceType type, const char* name);
+
+        /** Member of a CPU struct that mirrors a uniform or storage block, e.g. { "uViewProjection", offsetof(Camera, ViewProjection) } */
+        struct BlockMemberLayout {
+            const char* Name{};
+            uint32_t Offset{};
+        };
+
+        /**
+         * @brief Check a CPU struct against the layout of a uniform or storage block. Every mismatch is reported.
+         * @param blockName Name of the block (not the instance name)
+         * @param structSize sizeof the CPU struct. It must cover the whole block.
+         * @param members Members to check. Block members may be named with or without the "Block." prefix.
+         * @return true if the block exists and all members match
+         */
+        GLASS_API bool validateBlockLayout(const ShaderProgram* program, const char* blockName, uint64_t structSize, std::span<const BlockMemberLayout> members);
+
         /**
          * Set shader program uniforms
          */
@@ -1176,6 +1591,66 @@ namespace glass {
         GLASS_API void setUniform(const ShaderProgram* program, const char* name, const glm::mat3& uniform, bool transpose = false);
         GLASS_API void setUniform(const ShaderProgram* program, const char* name, const glm::mat4& uniform, bool transpose = false);
 
+        /** Set the elements of a vec4 array uniform, starting at the element the name refers to (the first one for the bare array name) */
+        GLASS_API void setUniform(const ShaderProgram* program, const char* name, std::span<const glm::vec4> uniforms);
+
+        /**
+         * Set shader program uniforms by names hashed at compile time, e.g. setUniform(program, "uModel"_hash, model)
+         * with glass::hash::literals. Skips strlen and hashing of the name on every call.
+         */
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, float uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec2 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec3 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec4 uniform);
+
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, int32_t uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec2 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec3 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec4 uniform);
+
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, uint32_t uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec2 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec3 uniform);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec4 uniform);
+
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, const glm::mat3& uniform, bool transpose = false);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, const glm::mat4& uniform, bool transpose = false);
+        GLASS_API void setUniform(const ShaderProgram* program, hash::CTStringHash name, std::span<const glm::vec4> uniforms);
+
+        /** Uniform location and type resolved once with resolveUniform. Valid for the program it was resolved with. */
+        enum class UniformHandle : uint64_t {
+            /** Setting an invalid uniform does nothing, like setting a uniform the program doesn't have */
+            Invalid = UINT32_MAX
+        };
+
+        /**
+         * @brief Look up a uniform once, so setting it later needs no name lookup at all.
+         * @return Handle of the uniform or UniformHandle::Invalid if the program has no active uniform with this name.
+         */
+        GLASS_API UniformHandle resolveUniform(const ShaderProgram* program, const char* name);
+        GLASS_API UniformHandle resolveUniform(const ShaderProgram* program, hash::CTStringHash name);
+
+        /**
+         * Set shader program uniforms through resolved handles. Debug builds assert that the value type matches the uniform type.
+         */
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, float value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec2 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec3 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec4 value);
+
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, int32_t value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec2 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec3 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec4 value);
+
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, uint32_t value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec2 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec3 value);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec4 value);
+
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, const glm::mat3& value, bool transpose = false);
+        GLASS_API void setUniform(const ShaderProgram* program, UniformHandle uniform, const glm::mat4& value, bool transpose = false);
+
         /**
          * @brief Bind texture to the shader program uniform slot.
          * @param program Shader program to bind the texture to
@@ -1184,6 +1659,29 @@ namespace glass {
          * @param slot (optional) binding slot. For binding multiple textures.
          */
         GLASS_API void setUniformTexture(const ShaderProgram* program, const char* name, ResourceID texture, uint32_t slot = 0);
+
+        /**
+         * @brief Bind texture to the shader program uniform slot and sample it through a sampler object.
+         * @param sampler Sampler from getOrCreateSampler. ResourceID::Null samples with the parameters of the texture.
+         */
+        GLASS_API void setUniformTexture(const ShaderProgram* program, const char* name, ResourceID texture, ResourceID sampler, uint32_t slot = 0);
+
+        /**
+         * Programs keep the last value written to every reflected uniform and skip setUniform calls that don't change it.
+         * These counters show how many uploads were issued and skipped. Calls for uniforms missing from the program are not counted.
+         */
+        struct UniformUploadStats {
+            uint64_t Issued{};
+            uint64_t Skipped{};
+        };
+
+        GLASS_API UniformUploadStats getUniformUploadStats(const ShaderProgram* program);
+        GLASS_API void resetUniformUploadStats(const ShaderProgram* program);
+
+        /** @brief Bind texture to the shader program sampler uniform resolved with resolveUniform. */
+        GLASS_API void setUniformTexture(const ShaderProgram* program, UniformHandle uniform, ResourceID texture, uint32_t slot = 0);
+        GLASS_API void setUniformTexture(const ShaderProgram* program, UniformHandle uniform, ResourceID texture, ResourceID sampler, uint32_t slot = 0);
+
         /**
          * @brief Bind a uniform buffer to the pipeline
          * @param program An instance of a shader program to use for binding lookup
@@ -1193,6 +1691,104 @@ namespace glass {
          */
         GLASS_API void setUniformBuffer(const ShaderProgram* program, const char* name, ResourceID buffer, uint32_t optBinding = INVALID_BINDING);
 
+        /**
+         * @brief Reserve a uniform block binding for a block name, before creating programs that use the block.
+         * Every program binds its uniform blocks to process wide bindings when it's created: the one declared with layout(binding = N),
+         * else the binding of the block name in other programs, else the lowest free one. Buffers bound once for a block stay bound to it
+         * across program switches.
+         * @return false if the name is bound elsewhere or the binding belongs to another block
+         */
+        GLASS_API bool reserveUniformBlockBinding(const char* name, uint32_t binding);
+
+        /** Process wide binding of a uniform block name, INVALID_BINDING if no program or reservation introduced the block */
+        GLASS_API uint32_t getUniformBlockBinding(const char* name);
+
+        /**
+         * @brief Bind textures to consecutive texture units starting at firstUnit. Units that already hold the texture are skipped.
+         * Uses a single glBindTextures call when the driver supports ARB_multi_bind (core since 4.4) and one bind per changed unit otherwise.
+         * Sampler uniforms should be assigned to the units with layout(binding = N) or set once with setUniform.
+         * ResourceID::Null unbinds the unit.
+         */
+        GLASS_API void bindTextures(uint32_t firstUnit, std::span<const ResourceID> textures);
+
+        /**
+         * @brief Bind whole uniform buffers to consecutive uniform block bindings starting at firstBinding.
+         * Bindings that already hold the buffer are skipped. Uses a single glBindBuffersBase call when the driver supports ARB_multi_bind (core since 4.4).
+         */
+        GLASS_API void bindUniformBuffers(uint32_t firstBinding, std::span<const ResourceID> buffers);
+
+        /**
+         * COMPUTE
+         */
+
+        /** Memory barrier bits. Describe how the data written by shaders is going to be used afterwards. */
+        enum EMemoryBarrierFlags {
+            EMBF_VertexAttribArray = 1 << 0,
+            EMBF_ElementArray = 1 << 1,
+            EMBF_Uniform = 1 << 2,
+            EMBF_TextureFetch = 1 << 3,
+            EMBF_ShaderImageAccess = 1 << 4,
+            EMBF_Command = 1 << 5,
+            EMBF_PixelBuffer = 1 << 6,
+            EMBF_TextureUpdate = 1 << 7,
+            EMBF_BufferUpdate = 1 << 8,
+            EMBF_Framebuffer = 1 << 9,
+            EMBF_AtomicCounter = 1 << 10,
+            EMBF_ShaderStorage = 1 << 11,
+            EMBF_All = (1 << 12) - 1,
+        };
+        using EMemoryBarrierMask = uint32_t;
+
+        /** Access of a shader to an image bound with bindImageTexture */
+        enum EImageAccess {
+            EIA_ReadOnly,
+            EIA_WriteOnly,
+            EIA_ReadWrite,
+        };
+
+        /** Pass to bindImageTexture to bind all layers of a 3D (or layered) texture. */
+        static constexpr int32_t ALL_LAYERS = -1;
+
+        /**
+         * @brief Dispatch the currently bound compute program.
+         * @param groupCountX Number of work groups in X dimension
+         * @param groupCountY Number of work groups in Y dimension
+         * @param groupCountZ Number of work groups in Z dimension
+         */
+        GLASS_API void dispatchCompute(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+
+        /**
+         * @brief Dispatch the currently bound compute program with group counts stored in a buffer (written by the GPU for example).
+         * @param buffer A buffer holding three uint32 values (x, y, z group counts)
+         * @param offset Offset in bytes of the group counts in the buffer
+         */
+        GLASS_API void dispatchComputeIndirect(ResourceID buffer, uint64_t offset = 0);
+
+        /**
+         * @brief Bind a buffer (or a range of it) to a shader storage block binding.
+         * @param buffer The buffer to bind. Any buffer type can be bound.
+         * @param binding The binding index declared with layout(binding = N) in GLSL
+         * @param offset Offset in bytes of the bound range
+         * @param size Size in bytes of the bound range. Use 0 to bind the whole buffer.
+         */
+        GLASS_API void bindStorageBuffer(ResourceID buffer, uint32_t binding, uint64_t offset = 0, uint64_t size = 0);
+
+        /**
+         * @brief Bind a texture level to an image unit for load/store access in shaders.
+         * @param texture The texture to bind. Its pixel format must be an uncompressed linear format other than EPF_RGB8.
+         * @param unit The image unit declared with layout(binding = N) in GLSL
+         * @param access How the shader is going to access the image
+         * @param mipLevel Mip level to bind
+         * @param layer Single layer of a 3D texture to bind or ALL_LAYERS
+         */
+        GLASS_API void bindImageTexture(ResourceID texture, uint32_t unit, EImageAccess access = EIA_ReadWrite, uint32_t mipLevel = 0, int32_t layer = ALL_LAYERS);
+
+        /**
+         * @brief Make shader writes visible to the following operations.
+         * @param barriers A valid mask of EMemoryBarrierFlags components (e.g. EMBF_ShaderStorage | EMBF_Command)
+         */
+        GLASS_API void memoryBarrier(EMemoryBarrierMask barriers);
+
         /**
          * DRAWING
          */
@@ -1222,5 +1818,479 @@ namespace glass {
          * @param indexType type of index.
          */
         GLASS_API void drawElements(EPrimitiveTopology topology, uint32_t indexCount, EIndexType indexType = EIT_UInt32);
+
+        /**
+         * Draw instanced arrays.
+         * @param instanceCount number of instances to draw
+         * @param baseInstance index of the first instance in the per instance data
+         */
+        GLASS_API void drawInstanced(EPrimitiveTopology topology, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0, uint32_t baseInstance = 0);
+
+        /**
+         * Draw instanced elements. Combined with a per instance layer index and a 2D array texture this draws
+         * meshes with different materials without rebinding textures.
+         * @param instanceCount number of instances to draw
+         * @param baseInstance index of the first instance in the per instance data
+         */
+        GLASS_API void drawElementsInstanced(EPrimitiveTopology topology, uint32_t indexCount, uint32_t instanceCount, EIndexType indexType = EIT_UInt32, uint32_t baseInstance = 0);
+
+        /** Indirect indexed draw command. Memory layout matches the OpenGL DrawElementsIndirectCommand. */
+        struct DrawElementsIndirectCommand {
+            /** Number of indices to draw */
+            uint32_t Count{};
+
+            /** Number of instances to draw */
+            uint32_t InstanceCount{};
+
+            /** First index in the bound element buffer */
+            uint32_t FirstIndex{};
+
+            /** Value added to each index before fetching the vertex */
+            int32_t BaseVertex{};
+
+            /** First instance for instanced vertex attributes */
+            uint32_t BaseInstance{};
+        };
+
+        /**
+         * Draw multiple ranges of the bound element buffer with commands stored in a buffer.
+         * @param topology Primitive topology (triangles, lines or points)
+         * @param indexType type of index.
+         * @param indirectBuffer A buffer of type EBT_Indirect holding DrawElementsIndirectCommand structs
+         * @param drawCount number of commands to execute
+         * @param offset offset in bytes of the first command in the indirect buffer
+         */
+        GLASS_API void multiDrawElementsIndirect(EPrimitiveTopology topology, EIndexType indexType, ResourceID indirectBuffer, uint32_t drawCount, uint64_t offset = 0);
+
+        /**
+         * GPU DRIVEN CULLING
+         */
+        class DrawCuller;
+
+        /** Specification of the GPU draw culler */
+        struct DrawCullerSpec {
+            /** EBT_Storage buffer with one glm::vec4 per object: xyz - world space bounding sphere center, w - radius. */
+            ResourceID BoundsBuffer{};
+
+            /** EBT_Storage buffer with one DrawElementsIndirectCommand per object. Commands with zero InstanceCount are skipped. */
+            ResourceID CommandsBuffer{};
+
+            /** Maximum number of objects that will be culled at once */
+            uint32_t MaxObjectCount{};
+        };
+
+        /**
+         * @brief Create a culler that runs frustum culling in a compute shader and compacts
+         * the draw commands of visible objects into an indirect buffer without any CPU readback.
+         */
+        GLASS_API DrawCuller* createDrawCuller(const DrawCullerSpec& spec);
+        GLASS_API void destroyDrawCuller(DrawCuller* culler);
+
+        /**
+         * @brief Dispatch culling of the first objectCount objects.
+         * @param culler A valid culler handle
+         * @param viewProjection Projection * View matrix used to build the frustum
+         * @param objectCount Number of objects to cull. Clamped to MaxObjectCount.
+         */
+        GLASS_API void cullDraws(DrawCuller* culler, const glm::mat4& viewProjection, uint32_t objectCount);
+
+        /**
+         * @brief Draw the commands that survived the last cullDraws call using the bound vertex and element buffers.
+         */
+        GLASS_API void drawCulled(const DrawCuller* culler, EPrimitiveTopology topology, EIndexType indexType = EIT_UInt32);
+
+        /** @brief Get the EBT_Indirect buffer with compacted commands of visible objects. */
+        GLASS_API ResourceID getDrawCullerCommandsBuffer(const DrawCuller* culler);
+
+        /** @brief Get the buffer with a single uint32 holding the number of visible objects. */
+        GLASS_API ResourceID getDrawCullerCountBuffer(const DrawCuller* culler);
     } // namespace gfx
+
+    namespace cull {
+        /** View frustum. Plane normals (xyz) point inside the frustum, w is the plane distance. */
+        struct Frustum {
+            glm::vec4 Planes[6]{};
+        };
+
+        /**
+         * @brief Extract normalized frustum planes from a view projection matrix.
+         * @param viewProjection Projection * View (* Model for object space culling) matrix
+         */
+        GLASS_API Frustum extractFrustum(const glm::mat4& viewProjection);
+
+        /** Bounding volumes of a meshlet used for culling */
+        struct MeshletBounds {
+            /** Bounding sphere center */
+            glm::vec3 Center{};
+
+            /** Bounding sphere radius */
+            float Radius{};
+
+            /** Apex of the normal cone */
+            glm::vec3 ConeApex{};
+
+            /** Average direction of the meshlet triangle normals */
+            glm::vec3 ConeAxis{};
+
+            /** Cosine-based cone cutoff. Values >= 1 mean that the meshlet can never be cone culled. */
+            float ConeCutoff{ 1.0f };
+        };
+
+        /** A cluster of triangles stored as a contiguous range of MeshletMesh::Indices */
+        struct Meshlet {
+            /** First index of the meshlet in MeshletMesh::Indices */
+            uint32_t FirstIndex{};
+
+            /** Number of triangles in the meshlet */
+            uint32_t TriangleCount{};
+
+            /** Number of unique vertices referenced by the meshlet */
+            uint32_t VertexCount{};
+
+            MeshletBounds Bounds{};
+        };
+
+        /** Specification for splitting a triangle list into meshlets */
+        struct MeshletBuildSpec {
+            /** Pointer to the first vertex position (3 floats) */
+            const float* Positions{};
+
+            /** Number of vertices */
+            uint32_t VertexCount{};
+
+            /** Distance in bytes between two vertex positions (e.g. sizeof(Vertex)) */
+            uint64_t PositionStrideInBytes{ sizeof(float) * 3 };
+
+            /** Triangle list indices */
+            const uint32_t* Indices{};
+
+            /** Number of indices. Must be a multiple of 3. */
+            uint32_t IndexCount{};
+
+            /** Maximum number of unique vertices per meshlet */
+            uint32_t MaxVertices{ 64 };
+
+            /** Maximum number of triangles per meshlet */
+            uint32_t MaxTriangles{ 124 };
+        };
+
+        /** Result of the meshlet build. Indices are reordered so that every meshlet is a contiguous range. */
+        struct MeshletMesh {
+            std::vector<Meshlet> Meshlets{};
+
+            /** Reordered triangle list. Upload it as an EIT_UInt32 element buffer. */
+            std::vector<uint32_t> Indices{};
+        };
+
+        /**
+         * @brief Split an indexed triangle list into meshlets and compute their bounding spheres and normal cones.
+         * Front faces are expected to have counter clockwise winding.
+         */
+        GLASS_API MeshletMesh buildMeshlets(const MeshletBuildSpec& spec);
+
+        /**
+         * @brief Cull meshlets against the frustum and their normal cones and emit draw commands for the visible ones.
+         * Adjacent visible meshlets are merged into a single command.
+         * @param mesh Meshlet mesh built with buildMeshlets
+         * @param frustum Frustum in the same space as mesh positions
+         * @param cameraPosition Camera position in the same space as mesh positions
+         * @param outCommands Commands are appended to this vector
+         * @param baseVertex BaseVertex value written to every command
+         * @param baseInstance BaseInstance value written to every command
+         * @return Number of meshlets that passed culling
+         */
+        GLASS_API uint32_t cullMeshlets(const MeshletMesh& mesh, const Frustum& frustum, const glm::vec3& cameraPosition, std::vector<gfx::DrawElementsIndirectCommand>& outCommands, int32_t baseVertex = 0, uint32_t baseInstance = 0);
+
+        /** Bounding spheres in structure of arrays layout. All spans must have the same size. */
+        struct BoundingSpheresSoA {
+            std::span<const float> CenterX{};
+            std::span<const float> CenterY{};
+            std::span<const float> CenterZ{};
+            std::span<const float> Radius{};
+        };
+
+        /** Axis aligned bounding boxes in structure of arrays layout. All spans must have the same size. */
+        struct BoundingBoxesSoA {
+            std::span<const float> MinX{};
+            std::span<const float> MinY{};
+            std::span<const float> MinZ{};
+            std::span<const float> MaxX{};
+            std::span<const float> MaxY{};
+            std::span<const float> MaxZ{};
+        };
+
+        /** Number of 64-bit words needed to store visibility bits of the given number of bounding volumes. */
+        static constexpr size_t getVisibilityMaskWordCount(size_t count) {
+            return (count + 63) / 64;
+        }
+
+        /** Check if bounding volume index is marked as visible in the visibility mask. */
+        static constexpr bool isVisible(std::span<const uint64_t> visibility, size_t index) {
+            return (visibility[index / 64] >> (index % 64)) & 1;
+        }
+
+        /** Implementation of the batch culling routines */
+        enum ECullKernel {
+            /** Pick the widest instruction set supported by the CPU */
+            ECK_Auto,
+            ECK_Scalar,
+            ECK_SSE41,
+            ECK_AVX2,
+            ECK_AVX512,
+        };
+
+        /**
+         * @brief Force a specific batch culling implementation (e.g. for benchmarking).
+         * Kernels that are not supported by the CPU fall back to the best supported one.
+         */
+        GLASS_API void setCullKernel(ECullKernel kernel);
+
+        /** @brief Get the batch culling implementation that is currently in use. */
+        GLASS_API ECullKernel getCullKernel();
+
+        /**
+         * @brief Test a batch of bounding spheres against the view frustum.
+         * @param viewProjection Projection * View matrix
+         * @param spheres Bounding spheres in world space
+         * @param outVisibility Bit i is set if sphere i is (potentially) visible. Must hold at least getVisibilityMaskWordCount(count) words.
+         */
+        GLASS_API void frustumCull(const glm::mat4& viewProjection, const BoundingSpheresSoA& spheres, std::span<uint64_t> outVisibility);
+
+        /**
+         * @brief Test a batch of axis aligned bounding boxes against the view frustum.
+         * @param viewProjection Projection * View matrix
+         * @param boxes Bounding boxes in world space
+         * @param outVisibility Bit i is set if box i is (potentially) visible. Must hold at least getVisibilityMaskWordCount(count) words.
+         */
+        GLASS_API void frustumCull(const glm::mat4& viewProjection, const BoundingBoxesSoA& boxes, std::span<uint64_t> outVisibility);
+    } // namespace cull
+
+    namespace image {
+        /** Read-only view of RGBA8 pixels */
+        struct ImageView {
+            const uint8_t* Pixels{};
+            int32_t Width{};
+            int32_t Height{};
+
+            /** Bytes between the starts of two rows. 0 means tightly packed (Width * 4). */
+            uint32_t RowPitch{ 0 };
+        };
+
+        /** Implementation of the image processing kernels (block encoders and mip filters) */
+        enum EImageKernel {
+            /** Pick the widest instruction set supported by the CPU */
+            EIK_Auto,
+            EIK_Scalar,
+            EIK_SSE41,
+            EIK_AVX2,
+        };
+
+        /**
+         * @brief Force a specific image kernel implementation (e.g. for benchmarking).
+         * Kernels that are not supported by the CPU fall back to the best supported one.
+         * All block encoder kernels produce identical output.
+         */
+        GLASS_API void setImageKernel(EImageKernel kernel);
+
+        /** @brief Get the image kernel implementation that is currently in use. */
+        GLASS_API EImageKernel getImageKernel();
+
+        /** Size in bytes of an image of the given size compressed to EPF_BC1, EPF_BC4 or EPF_BC5 */
+        GLASS_API uint64_t getCompressedImageSize(gfx::EPixelFormat format, int32_t width, int32_t height);
+
+        /**
+         * @brief Compress RGBA8 pixels for runtime generated textures.
+         * EPF_BC1 encodes RGB, EPF_BC4 the red channel and EPF_BC5 the red and green channels.
+         * Rows of blocks are split between threads. Partial blocks at the right and bottom edges repeat the edge pixels.
+         * @param out Must hold getCompressedImageSize(format, width, height) bytes. Can be used directly as
+         *        TextureSpec::InitialData, TextureSpec::MipData or with writeTextureData.
+         * @param threadCount Number of threads to use. 0 uses all hardware threads.
+         */
+        GLASS_API void compressImage(const ImageView& source, gfx::EPixelFormat format, std::span<uint8_t> out, uint32_t threadCount = 0);
+
+        /**
+         * @brief Decode EPF_BC1, EPF_BC4 or EPF_BC5 blocks into tightly packed RGBA8 pixels the way GPUs decode them.
+         * Channels missing from the format are 0, alpha is 255 (BC1 transparent texels have alpha 0).
+         * @param outPixels Must hold width * height * 4 bytes
+         */
+        GLASS_API void decompressImage(std::span<const uint8_t> blocks, gfx::EPixelFormat format, int32_t width, int32_t height, std::span<uint8_t> outPixels);
+
+        /** Filter used to compute every mip level from the one above it */
+        enum EMipFilter {
+            /** Average of 2x2 texels. Fast, but slightly blurry and prone to aliasing. */
+            EMF_Box,
+
+            /** Kaiser windowed sinc over 6x6 texels. Sharper levels with less aliasing. */
+            EMF_Kaiser,
+        };
+
+        /** Specification for CPU mip chain generation */
+        struct MipChainSpec {
+            EMipFilter Filter{ EMF_Box };
+
+            /** Color channels are sRGB encoded (e.g. for EPF_SRGBA8 textures) and are filtered in linear space. Alpha is always linear. */
+            bool SRGB{ false };
+
+            /** Number of levels including the source image. 0 means the full chain. */
+            uint32_t MipLevels{ 0 };
+
+            /** Number of threads to filter rows of a level with. 0 uses all hardware threads. */
+            uint32_t ThreadCount{ 0 };
+        };
+
+        /** Tightly packed RGBA8 mip chain. Move only, since Levels points into Pixels. */
+        struct MipChain {
+            MipChain() = default;
+            MipChain(MipChain&&) = default;
+            MipChain& operator=(MipChain&&) = default;
+            MipChain(const MipChain&) = delete;
+            MipChain& operator=(const MipChain&) = delete;
+
+            int32_t Width{};
+            int32_t Height{};
+
+            /** Every level back to back, finest first */
+            std::vector<uint8_t> Pixels;
+
+            /** Start of every level in Pixels. Can be passed as TextureSpec::MipData with MipLevels = Levels.size(). */
+            std::vector<const void*> Levels;
+
+            /** View of a single level, e.g. to compress it with compressImage */
+            ImageView getLevel(uint32_t level) const {
+                return { static_cast<const uint8_t*>(Levels[level]), Width >> level > 1 ? Width >> level : 1, Height >> level > 1 ? Height >> level : 1, 0 };
+            }
+        };
+
+        /**
+         * @brief Generate a mip chain on the CPU, ahead of the upload.
+         * Doesn't touch GL, so it can run on a worker thread. Rows of every level are split between threads.
+         * Unlike glGenerateMipmap the result is the same on every driver and sRGB colors are filtered correctly.
+         * @param source RGBA8 pixels of the finest level
+         */
+        GLASS_API MipChain generateMipChain(const ImageView& source, const MipChainSpec& spec = {});
+
+        /** Size in bytes of a planar YUV 4:2:0 image: full size Y plane, then U and V planes of half the size (rounded up) */
+        GLASS_API uint64_t getYUV420ImageSize(int32_t width, int32_t height);
+
+        /**
+         * @brief Convert RGBA8 pixels to planar YUV 4:2:0 (I420) with BT.601 limited range coefficients, e.g. for video encoders.
+         * Chroma is the average of 2x2 pixels. Alpha is ignored.
+         * @param out Must hold getYUV420ImageSize(width, height) bytes
+         */
+        GLASS_API void convertImageToYUV420(const ImageView& source, std::span<uint8_t> out);
+    } // namespace image
+
+    namespace atlas {
+        class Atlas;
+
+        /** Handle of an image stored in an atlas */
+        enum class AtlasEntry : uint32_t {
+            Invalid = UINT32_MAX
+        };
+
+        /** Specification for atlas creation */
+        struct AtlasSpec {
+            /** Size of every page texture */
+            int32_t PageWidth{ 2048 };
+            int32_t PageHeight{ 2048 };
+
+            /** Pixel format of the pages and of the inserted images. Must be uncompressed. */
+            gfx::EPixelFormat Format{ gfx::EPF_RGBA8 };
+
+            /** Pages are created when the existing ones are full. Insertion fails once MaxPages are full. */
+            uint32_t MaxPages{ 4 };
+
+            /** Texels around every image that repeat its edges, so filtering doesn't bleed in neighbouring images */
+            int32_t Padding{ 1 };
+
+            /**
+             * Store the pages as layers of one 2D array texture with MaxPages layers, allocated up front.
+             * Every region then shares the texture and AtlasRegion::Page is the layer to sample.
+             */
+            bool ArrayPages{ false };
+
+            gfx::SamplerSpec Sampler{};
+        };
+
+        /** Location of an image inside of an atlas */
+        struct AtlasRegion {
+            gfx::ResourceID Texture{ gfx::ResourceID::Null };
+
+            /** Page of the atlas, also the layer of the texture with AtlasSpec::ArrayPages */
+            uint32_t Page{};
+
+            /** Position and size of the image in texels, without padding */
+            int32_t X{};
+            int32_t Y{};
+            int32_t Width{};
+            int32_t Height{};
+
+            /** Texture coordinates of the image corners: (u0, v0, u1, v1) */
+            glm::vec4 UV{};
+
+            /** Map a texture coordinate of the original image into the atlas page */
+            glm::vec2 remapUV(glm::vec2 uv) const {
+                return { UV.x + (UV.z - UV.x) * uv.x, UV.y + (UV.w - UV.y) * uv.y };
+            }
+        };
+
+        GLASS_API Atlas* createAtlas(const AtlasSpec& spec);
+        GLASS_API void destroyAtlas(Atlas* atlas);
+
+        /**
+         * @brief Pack an image into the first page with enough room and upload it.
+         * @param pixels Tightly packed pixels in the atlas format
+         * @return Entry of the image or AtlasEntry::Invalid if it is larger than a page or all pages are full
+         */
+        GLASS_API AtlasEntry insertImage(Atlas* atlas, int32_t width, int32_t height, const void* pixels);
+
+        /** Free the space of an image so later insertions can reuse it. The texels are left as they are. */
+        GLASS_API void removeImage(Atlas* atlas, AtlasEntry entry);
+
+        /** Get the page texture and texture coordinates of an image */
+        GLASS_API AtlasRegion getAtlasRegion(const Atlas* atlas, AtlasEntry entry);
+
+        GLASS_API uint32_t getAtlasPageCount(const Atlas* atlas);
+        GLASS_API gfx::ResourceID getAtlasPageTexture(const Atlas* atlas, uint32_t page);
+
+        /** Fraction of the page area covered by images (including padding) */
+        GLASS_API float getAtlasPageOccupancy(const Atlas* atlas, uint32_t page);
+    } // namespace atlas
+
+    namespace capture {
+        class FrameRecorder;
+
+        /** Specification for frame recorder creation */
+        struct FrameRecorderSpec {
+            /**
+             * File to write the Y4M stream to. A value starting with '|' runs the rest as a shell command and pipes
+             * the stream into its standard input, e.g. "| ffmpeg -y -i - capture.mp4". The recorder keeps a copy.
+             */
+            const char* Output{};
+
+            /** Frame rate written to the stream header */
+            uint32_t FrameRateNumerator{ 60 };
+            uint32_t FrameRateDenominator{ 1 };
+        };
+
+        /**
+         * @brief Create a recorder that writes framebuffer captures as a raw YUV 4:2:0 Y4M stream.
+         * Frames are read back asynchronously and converted and written on a worker thread, so recording
+         * overlaps rendering of the following frames.
+         * @return Recorder or nullptr if the output can't be opened
+         */
+        GLASS_API FrameRecorder* createFrameRecorder(const FrameRecorderSpec& spec);
+
+        /** Finish writing the captured frames and close the output */
+        GLASS_API void destroyFrameRecorder(FrameRecorder* recorder);
+
+        /**
+         * @brief Capture the current content of an RGBA8 framebuffer attachment as the next frame.
+         * Every frame must have the size of the first one, frames of other sizes are dropped.
+         */
+        GLASS_API void captureFrame(FrameRecorder* recorder, const gfx::FrameBuffer* fb, uint8_t attachmentIndex = 0);
+
+        /** Number of frames written to the output so far */
+        GLASS_API uint64_t getRecordedFrameCount(const FrameRecorder* recorder);
+    } // namespace capture
 } // namespace glass
\ No newline at end of file
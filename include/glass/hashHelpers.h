@@ -0,0 +1,89 @@
+#pragma once
+
+#include "cstdint"
+#include "functional"
+
+namespace glass::hash {
+    template <class T>
+    void hashCombine(uint64_t& seed, const T& v) {
+        std::hash<T> hasher;
+        seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    // FNV-1a constexpr hashing functions. Loops instead of recursion, so runtime strings hash without a call per character.
+    constexpr uint64_t hash32(const char* str, uint64_t n, uint32_t basis = UINT32_C(2166136261)) {
+        for (uint64_t i = 0; i < n; ++i) {
+            basis = (basis ^ str[i]) * UINT32_C(16777619);
+        }
+        return basis;
+    }
+
+    constexpr uint64_t hash32(const wchar_t* str, uint64_t n, uint32_t basis = UINT32_C(2166136261)) {
+        for (uint64_t i = 0; i < n; ++i) {
+            basis = (basis ^ str[i]) * UINT32_C(16777619);
+        }
+        return basis;
+    }
+
+    constexpr uint64_t hash64(const char* str, uint64_t n, uint64_t basis = UINT64_C(14695981039346656037)) {
+        for (uint64_t i = 0; i < n; ++i) {
+            basis = (basis ^ str[i]) * UINT64_C(1099511628211);
+        }
+        return basis;
+    }
+
+    constexpr uint64_t hash64(const wchar_t* str, uint64_t n, uint64_t basis = UINT64_C(14695981039346656037)) {
+        for (uint64_t i = 0; i < n; ++i) {
+            basis = (basis ^ str[i]) * UINT64_C(1099511628211);
+        }
+        return basis;
+    }
+
+    template <uint64_t N>
+    constexpr uint64_t hash32(const char (&s)[N]) {
+        return hash32(s, N - 1);
+    }
+    template <uint64_t N>
+    constexpr uint64_t hash32(const wchar_t (&s)[N]) {
+        return hash32(s, N - 1);
+    }
+
+    template <uint64_t N>
+    constexpr uint64_t hash64(const char (&s)[N]) {
+        return hash64(s, N - 1);
+    }
+    template <uint64_t N>
+    constexpr uint64_t hash64(const wchar_t (&s)[N]) {
+        return hash64(s, N - 1);
+    }
+
+    /**
+     * String literal hashed at compile time. The narrow string is kept for lookups that need the name itself
+     * (e.g. asking the driver for a uniform that is not cached yet), so it must outlive the hash.
+     */
+    struct CTStringHash {
+        uint64_t value;
+        const char* str{};
+
+        template <uint64_t N>
+        consteval CTStringHash(const char (&str)[N])
+            : value(hash64<N>(str))
+            , str(str) {}
+        template <uint64_t N>
+        consteval CTStringHash(const wchar_t (&str)[N])
+            : value(hash64<N>(str)) {}
+
+        consteval CTStringHash(const char* str, uint64_t n)
+            : value(hash64(str, n))
+            , str(str) {}
+
+        constexpr operator uint64_t() const { return value; }
+    };
+
+    namespace literals {
+        /** "uModel"_hash */
+        consteval CTStringHash operator""_hash(const char* str, size_t n) {
+            return CTStringHash(str, n);
+        }
+    } // namespace literals
+} // namespace glass::hash
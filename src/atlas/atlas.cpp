@@ -0,0 +1,188 @@
+#include "atlas.h"
+#include "context/glInternal.h"
+#include "cassert"
+#include "algorithm"
+#include "cstring"
+#include "memory"
+
+namespace glass::atlas {
+    Atlas::Atlas(const AtlasSpec& spec)
+        : m_Spec(spec) {
+        assert(spec.PageWidth > 0 && spec.PageHeight > 0 && spec.MaxPages > 0 && spec.Padding >= 0);
+        assert(gfx::getPixelFormatSize(spec.Format) != 0 && "Atlas pages need an uncompressed color format");
+    }
+
+    Atlas::~Atlas() {
+        if (m_Spec.ArrayPages) {
+            if (!m_Pages.empty()) {
+                gfx::destroyTexture(m_Pages.front().Texture);
+            }
+            return;
+        }
+
+        for (const Page& page : m_Pages) {
+            gfx::destroyTexture(page.Texture);
+        }
+    }
+
+    void Atlas::addPage() {
+        // Array pages share the texture created with the first page
+        if (m_Spec.ArrayPages && !m_Pages.empty()) {
+            m_Pages.push_back({ m_Pages.front().Texture, MaxRectsPacker(m_Spec.PageWidth, m_Spec.PageHeight) });
+            return;
+        }
+
+        gfx::TextureSpec spec{};
+        spec.Type = m_Spec.ArrayPages ? gfx::ETT_Texture2DArray : gfx::ETT_Texture2D;
+        spec.Format = m_Spec.Format;
+        spec.Width = m_Spec.PageWidth;
+        spec.Height = m_Spec.PageHeight;
+        spec.Depth = m_Spec.ArrayPages ? static_cast<int32_t>(m_Spec.MaxPages) : 1;
+        spec.GenerateMipmaps = false;
+        spec.Sampler = m_Spec.Sampler;
+
+        m_Pages.push_back({ gfx::createTexture(spec), MaxRectsPacker(m_Spec.PageWidth, m_Spec.PageHeight) });
+    }
+
+    void Atlas::upload(uint32_t page, const PackRect& rect, int32_t width, int32_t height, const void* pixels) {
+        const gfx::ResourceID texture = m_Pages[page].Texture;
+        const int32_t layer = m_Spec.ArrayPages ? static_cast<int32_t>(page) : 0;
+        if (m_Spec.Padding == 0) {
+            gfx::writeTextureData(texture, 0, rect.X, rect.Y, layer, width, height, 1, pixels);
+            return;
+        }
+
+        // Build the padded image with its edge texels repeated into the padding
+        const uint32_t pixelSize = gfx::getPixelFormatSize(m_Spec.Format);
+        const uint8_t* source = static_cast<const uint8_t*>(pixels);
+        std::vector<uint8_t> padded(static_cast<size_t>(rect.Width) * rect.Height * pixelSize);
+        for (int32_t y = 0; y < rect.Height; ++y) {
+            const int32_t sourceY = std::clamp(y - m_Spec.Padding, 0, height - 1);
+            for (int32_t x = 0; x < rect.Width; ++x) {
+                const int32_t sourceX = std::clamp(x - m_Spec.Padding, 0, width - 1);
+                std::memcpy(padded.data() + (static_cast<size_t>(y) * rect.Width + x) * pixelSize, source + (static_cast<size_t>(sourceY) * width + sourceX) * pixelSize, pixelSize);
+            }
+        }
+
+        gfx::writeTextureData(texture, 0, rect.X, rect.Y, layer, rect.Width, rect.Height, 1, padded.data());
+    }
+
+    AtlasEntry Atlas::insert(int32_t width, int32_t height, const void* pixels) {
+        assert(width > 0 && height > 0 && pixels);
+
+        const int32_t paddedWidth = width + m_Spec.Padding * 2;
+        const int32_t paddedHeight = height + m_Spec.Padding * 2;
+        if (paddedWidth > m_Spec.PageWidth || paddedHeight > m_Spec.PageHeight) {
+            return AtlasEntry::Invalid;
+        }
+
+        std::optional<PackRect> rect{};
+        uint32_t page = 0;
+        for (; page < m_Pages.size() && !rect; ++page) {
+            rect = m_Pages[page].Packer.insert(paddedWidth, paddedHeight);
+        }
+
+        if (rect) {
+            --page;
+        } else if (m_Pages.size() < m_Spec.MaxPages) {
+            addPage();
+            page = getPageCount() - 1;
+            rect = m_Pages[page].Packer.insert(paddedWidth, paddedHeight);
+        } else {
+            return AtlasEntry::Invalid;
+        }
+
+        upload(page, *rect, width, height, pixels);
+
+        uint32_t index = 0;
+        if (!m_FreeEntries.empty()) {
+            index = m_FreeEntries.back();
+            m_FreeEntries.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_Entries.size());
+            m_Entries.emplace_back();
+        }
+
+        m_Entries[index] = { page, *rect, true };
+        return static_cast<AtlasEntry>(index);
+    }
+
+    void Atlas::remove(AtlasEntry entry) {
+        const uint32_t index = static_cast<uint32_t>(entry);
+        if (index >= m_Entries.size() || !m_Entries[index].Alive) {
+            return;
+        }
+
+        Entry& removed = m_Entries[index];
+        m_Pages[removed.Page].Packer.remove(removed.Rect);
+        removed.Alive = false;
+        m_FreeEntries.push_back(index);
+    }
+
+    AtlasRegion Atlas::getRegion(AtlasEntry entry) const {
+        const uint32_t index = static_cast<uint32_t>(entry);
+        if (index >= m_Entries.size() || !m_Entries[index].Alive) {
+            return {};
+        }
+
+        const Entry& found = m_Entries[index];
+        AtlasRegion region{};
+        region.Texture = m_Pages[found.Page].Texture;
+        region.Page = found.Page;
+        region.X = found.Rect.X + m_Spec.Padding;
+        region.Y = found.Rect.Y + m_Spec.Padding;
+        region.Width = found.Rect.Width - m_Spec.Padding * 2;
+        region.Height = found.Rect.Height - m_Spec.Padding * 2;
+
+        const float invWidth = 1.0f / static_cast<float>(m_Spec.PageWidth);
+        const float invHeight = 1.0f / static_cast<float>(m_Spec.PageHeight);
+        region.UV = glm::vec4(region.X * invWidth, region.Y * invHeight, (region.X + region.Width) * invWidth, (region.Y + region.Height) * invHeight);
+        return region;
+    }
+
+    float Atlas::getPageOccupancy(uint32_t page) const {
+        const MaxRectsPacker& packer = m_Pages[page].Packer;
+        return static_cast<float>(static_cast<double>(packer.getUsedArea()) / (static_cast<double>(packer.getWidth()) * packer.getHeight()));
+    }
+
+    static std::vector<std::unique_ptr<Atlas>> GAtlasRegistry{};
+
+    Atlas* createAtlas(const AtlasSpec& spec) {
+        return GAtlasRegistry.emplace_back(std::make_unique<Atlas>(spec)).get();
+    }
+
+    void destroyAtlas(Atlas* atlas) {
+        auto iter = std::ranges::find_if(GAtlasRegistry, [atlas](const std::unique_ptr<Atlas>& a) { return a.get() == atlas; });
+        if (iter != GAtlasRegistry.end()) {
+            GAtlasRegistry.erase(iter);
+        }
+    }
+
+    void freeAtlasRegistry() {
+        GAtlasRegistry.clear();
+    }
+
+    AtlasEntry insertImage(Atlas* atlas, int32_t width, int32_t height, const void* pixels) {
+        return atlas->insert(width, height, pixels);
+    }
+
+    void removeImage(Atlas* atlas, AtlasEntry entry) {
+        atlas->remove(entry);
+    }
+
+    AtlasRegion getAtlasRegion(const Atlas* atlas, AtlasEntry entry) {
+        return atlas->getRegion(entry);
+    }
+
+    uint32_t getAtlasPageCount(const Atlas* atlas) {
+        return atlas->getPageCount();
+    }
+
+    gfx::ResourceID getAtlasPageTexture(const Atlas* atlas, uint32_t page) {
+        return atlas->getPageTexture(page);
+    }
+
+    float getAtlasPageOccupancy(const Atlas* atlas, uint32_t page) {
+        return atlas->getPageOccupancy(page);
+    }
+} // namespace glass::atlas
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "maxRectsPacker.h"
+
+namespace glass::atlas {
+    class Atlas {
+    public:
+        Atlas(const AtlasSpec& spec);
+        ~Atlas();
+
+        Atlas(const Atlas&) = delete;
+        Atlas& operator=(const Atlas&) = delete;
+
+        AtlasEntry insert(int32_t width, int32_t height, const void* pixels);
+        void remove(AtlasEntry entry);
+        AtlasRegion getRegion(AtlasEntry entry) const;
+
+        inline uint32_t getPageCount() const { return static_cast<uint32_t>(m_Pages.size()); }
+        inline gfx::ResourceID getPageTexture(uint32_t page) const { return m_Pages[page].Texture; }
+        float getPageOccupancy(uint32_t page) const;
+
+    private:
+        void addPage();
+        void upload(uint32_t page, const PackRect& rect, int32_t width, int32_t height, const void* pixels);
+
+    private:
+        struct Page {
+            gfx::ResourceID Texture{ gfx::ResourceID::Null };
+            MaxRectsPacker Packer;
+        };
+
+        struct Entry {
+            uint32_t Page{};
+
+            /** Allocated rectangle including the padding */
+            PackRect Rect{};
+            bool Alive{};
+        };
+
+        AtlasSpec m_Spec{};
+        std::vector<Page> m_Pages;
+        std::vector<Entry> m_Entries;
+        std::vector<uint32_t> m_FreeEntries;
+    };
+
+    void freeAtlasRegistry();
+} // namespace glass::atlas
@@ -0,0 +1,134 @@
+#include "maxRectsPacker.h"
+#include "algorithm"
+#include "limits"
+
+namespace glass::atlas {
+    static bool intersects(const PackRect& a, const PackRect& b) {
+        return a.X < b.X + b.Width && b.X < a.X + a.Width && a.Y < b.Y + b.Height && b.Y < a.Y + a.Height;
+    }
+
+    static bool contains(const PackRect& outer, const PackRect& inner) {
+        return inner.X >= outer.X && inner.Y >= outer.Y && inner.X + inner.Width <= outer.X + outer.Width && inner.Y + inner.Height <= outer.Y + outer.Height;
+    }
+
+    MaxRectsPacker::MaxRectsPacker(int32_t width, int32_t height)
+        : m_Width(width), m_Height(height) {
+        m_FreeRects.push_back({ 0, 0, width, height });
+    }
+
+    std::optional<PackRect> MaxRectsPacker::insert(int32_t width, int32_t height) {
+        if (width <= 0 || height <= 0) {
+            return std::nullopt;
+        }
+
+        const PackRect* best = nullptr;
+        int32_t bestShortSide = std::numeric_limits<int32_t>::max();
+        int32_t bestLongSide = std::numeric_limits<int32_t>::max();
+        for (const PackRect& free : m_FreeRects) {
+            if (free.Width < width || free.Height < height) {
+                continue;
+            }
+
+            const int32_t leftoverX = free.Width - width;
+            const int32_t leftoverY = free.Height - height;
+            const int32_t shortSide = std::min(leftoverX, leftoverY);
+            const int32_t longSide = std::max(leftoverX, leftoverY);
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                best = &free;
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+            }
+        }
+
+        if (!best) {
+            return std::nullopt;
+        }
+
+        const PackRect placed{ best->X, best->Y, width, height };
+        splitFreeRects(placed);
+        pruneFreeRects();
+
+        m_UsedArea += static_cast<uint64_t>(width) * height;
+        return placed;
+    }
+
+    void MaxRectsPacker::remove(const PackRect& rect) {
+        m_FreeRects.push_back(rect);
+        mergeFreeRects();
+        pruneFreeRects();
+
+        m_UsedArea -= static_cast<uint64_t>(rect.Width) * rect.Height;
+    }
+
+    void MaxRectsPacker::splitFreeRects(const PackRect& used) {
+        std::vector<PackRect> pieces;
+        for (auto it = m_FreeRects.begin(); it != m_FreeRects.end();) {
+            const PackRect free = *it;
+            if (!intersects(free, used)) {
+                ++it;
+                continue;
+            }
+
+            // Keep the maximal parts of the free rectangle on each side of the used one
+            if (used.X > free.X) {
+                pieces.push_back({ free.X, free.Y, used.X - free.X, free.Height });
+            }
+            if (used.X + used.Width < free.X + free.Width) {
+                pieces.push_back({ used.X + used.Width, free.Y, free.X + free.Width - used.X - used.Width, free.Height });
+            }
+            if (used.Y > free.Y) {
+                pieces.push_back({ free.X, free.Y, free.Width, used.Y - free.Y });
+            }
+            if (used.Y + used.Height < free.Y + free.Height) {
+                pieces.push_back({ free.X, used.Y + used.Height, free.Width, free.Y + free.Height - used.Y - used.Height });
+            }
+
+            it = m_FreeRects.erase(it);
+        }
+
+        m_FreeRects.insert(m_FreeRects.end(), pieces.begin(), pieces.end());
+    }
+
+    // Freed rectangles are not maximal. Merging neighbours with a full shared edge recovers most of the lost space.
+    void MaxRectsPacker::mergeFreeRects() {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < m_FreeRects.size() && !merged; ++i) {
+                for (size_t j = i + 1; j < m_FreeRects.size() && !merged; ++j) {
+                    PackRect& a = m_FreeRects[i];
+                    const PackRect& b = m_FreeRects[j];
+
+                    if (a.X == b.X && a.Width == b.Width && (a.Y + a.Height == b.Y || b.Y + b.Height == a.Y)) {
+                        a.Y = std::min(a.Y, b.Y);
+                        a.Height += b.Height;
+                        merged = true;
+                    } else if (a.Y == b.Y && a.Height == b.Height && (a.X + a.Width == b.X || b.X + b.Width == a.X)) {
+                        a.X = std::min(a.X, b.X);
+                        a.Width += b.Width;
+                        merged = true;
+                    }
+
+                    if (merged) {
+                        m_FreeRects.erase(m_FreeRects.begin() + j);
+                    }
+                }
+            }
+        }
+    }
+
+    void MaxRectsPacker::pruneFreeRects() {
+        for (size_t i = 0; i < m_FreeRects.size(); ++i) {
+            for (size_t j = i + 1; j < m_FreeRects.size();) {
+                if (contains(m_FreeRects[i], m_FreeRects[j])) {
+                    m_FreeRects.erase(m_FreeRects.begin() + j);
+                } else if (contains(m_FreeRects[j], m_FreeRects[i])) {
+                    m_FreeRects.erase(m_FreeRects.begin() + i);
+                    j = i + 1;
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+} // namespace glass::atlas
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "cstdint"
+#include "optional"
+#include "vector"
+
+namespace glass::atlas {
+    struct PackRect {
+        int32_t X{};
+        int32_t Y{};
+        int32_t Width{};
+        int32_t Height{};
+    };
+
+    /**
+     * Online MaxRects bin packer. Keeps a list of (possibly overlapping) free rectangles that never intersect placed ones.
+     * New rectangles go where they leave the shortest side of a free rectangle (best short side fit).
+     */
+    class MaxRectsPacker {
+    public:
+        MaxRectsPacker(int32_t width, int32_t height);
+
+        /** Find room for a rectangle and mark it as used */
+        std::optional<PackRect> insert(int32_t width, int32_t height);
+
+        /** Return a rectangle previously returned by insert */
+        void remove(const PackRect& rect);
+
+        inline uint64_t getUsedArea() const { return m_UsedArea; }
+        inline int32_t getWidth() const { return m_Width; }
+        inline int32_t getHeight() const { return m_Height; }
+
+    private:
+        void splitFreeRects(const PackRect& used);
+        void mergeFreeRects();
+        void pruneFreeRects();
+
+    private:
+        int32_t m_Width{};
+        int32_t m_Height{};
+        uint64_t m_UsedArea{};
+        std::vector<PackRect> m_FreeRects;
+    };
+} // namespace glass::atlas
@@ -0,0 +1,203 @@
+#include "frameRecorder.h"
+#include "image/yuvKernels.h"
+#include "context/glTexture.h"
+#include "cassert"
+#include "cstring"
+#include "iostream"
+#include "memory"
+#include "algorithm"
+
+#ifdef _WIN32
+    #define GLASS_POPEN _popen
+    #define GLASS_PCLOSE _pclose
+#else
+    #define GLASS_POPEN popen
+    #define GLASS_PCLOSE pclose
+#endif
+
+namespace glass::capture {
+    FrameRecorder::FrameRecorder(const FrameRecorderSpec& spec)
+        : m_Spec(spec) {
+        assert(spec.Output && spec.FrameRateNumerator > 0 && spec.FrameRateDenominator > 0);
+
+        m_OutputPath = spec.Output;
+        m_Spec.Output = m_OutputPath.c_str();
+
+        if (m_OutputPath[0] == '|') {
+            m_IsPipe = true;
+#ifdef _WIN32
+            m_Output = GLASS_POPEN(m_OutputPath.c_str() + 1, "wb");
+#else
+            m_Output = GLASS_POPEN(m_OutputPath.c_str() + 1, "w");
+#endif
+        } else {
+            m_Output = std::fopen(m_OutputPath.c_str(), "wb");
+        }
+
+        if (!m_Output) {
+            std::cout << std::format("GLASS error: Failed to open frame capture output: {}", m_OutputPath);
+            return;
+        }
+
+        m_Worker = std::thread([this] { runWorker(); });
+    }
+
+    FrameRecorder::~FrameRecorder() {
+        if (!m_Output) {
+            return;
+        }
+
+        while (!m_PendingReadbacks.empty()) {
+            deliver(m_PendingReadbacks.front());
+            m_PendingReadbacks.pop_front();
+        }
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_FrameChanged.notify_all();
+        m_Worker.join();
+
+        if (m_IsPipe) {
+            GLASS_PCLOSE(m_Output);
+        } else {
+            std::fclose(m_Output);
+        }
+    }
+
+    void FrameRecorder::capture(const gfx::FrameBuffer* fb, uint8_t attachmentIndex) {
+        const gfx::EPixelFormat format = gfx::getTexturePixelFormat(gfx::getFrameBufferColorAttachmentTexture(fb, attachmentIndex));
+        assert((format == gfx::EPF_RGBA8 || format == gfx::EPF_SRGBA8) && "Frame capture needs an RGBA8 attachment");
+        (void)format;
+
+        const uint32_t width = gfx::getFrameBufferWidth(fb);
+        const uint32_t height = gfx::getFrameBufferHeight(fb);
+        if (m_Width == 0) {
+            m_Width = width;
+            m_Height = height;
+        } else if (m_Width != width || m_Height != height) {
+            std::cout << std::format("GLASS warning: Dropped a {}x{} frame from a {}x{} capture.", width, height, m_Width, m_Height);
+            return;
+        }
+
+        // Hand over every finished read, and wait for the oldest one before its ring slot is reused
+        while (!m_PendingReadbacks.empty() && gfx::isReadbackReady(m_PendingReadbacks.front())) {
+            deliver(m_PendingReadbacks.front());
+            m_PendingReadbacks.pop_front();
+        }
+
+        if (m_PendingReadbacks.size() >= gfx::MAX_PENDING_READBACKS - 1) {
+            deliver(m_PendingReadbacks.front());
+            m_PendingReadbacks.pop_front();
+        }
+
+        m_PendingReadbacks.push_back(gfx::readFramebufferAsync(fb, attachmentIndex, 0, 0, width, height));
+    }
+
+    void FrameRecorder::deliver(gfx::ReadbackTicket ticket) {
+        const void* pixels = gfx::mapReadback(ticket);
+        if (!pixels) {
+            std::cout << std::format("GLASS warning: Dropped a captured frame, its readback expired.");
+            return;
+        }
+
+        Frame& frame = m_Frames[m_NextFill];
+        {
+            std::unique_lock lock(m_Mutex);
+            m_FrameChanged.wait(lock, [&frame] { return !frame.Full; });
+        }
+
+        frame.Pixels.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+        std::memcpy(frame.Pixels.data(), pixels, frame.Pixels.size());
+        gfx::unmapReadback(ticket);
+
+        {
+            std::lock_guard lock(m_Mutex);
+            frame.Full = true;
+        }
+        m_FrameChanged.notify_all();
+        m_NextFill ^= 1;
+    }
+
+    bool FrameRecorder::write(const void* data, size_t size) {
+        if (m_WriteFailed || std::fwrite(data, 1, size, m_Output) != size) {
+            if (!m_WriteFailed) {
+                std::cout << std::format("GLASS error: Failed to write to frame capture output: {}", m_OutputPath);
+            }
+            m_WriteFailed = true;
+        }
+
+        return !m_WriteFailed;
+    }
+
+    void FrameRecorder::runWorker() {
+        uint32_t nextConvert = 0;
+        bool headerWritten = false;
+        while (true) {
+            Frame& frame = m_Frames[nextConvert];
+            {
+                std::unique_lock lock(m_Mutex);
+                m_FrameChanged.wait(lock, [this, &frame] { return frame.Full || m_Stopping; });
+                if (!frame.Full) {
+                    break;
+                }
+            }
+
+            if (!headerWritten) {
+                const std::string header = std::format("YUV4MPEG2 W{} H{} F{}:{} Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n", m_Width, m_Height, m_Spec.FrameRateNumerator, m_Spec.FrameRateDenominator);
+                write(header.data(), header.size());
+                headerWritten = true;
+            }
+
+            // GL rows start at the bottom of the image, Y4M rows at the top
+            m_Converted.resize(image::getYUV420ImageSize(static_cast<int32_t>(m_Width), static_cast<int32_t>(m_Height)));
+            const int64_t rowPitch = static_cast<int64_t>(m_Width) * 4;
+            image::convertToYUV420(frame.Pixels.data() + rowPitch * (m_Height - 1), -rowPitch, m_Width, m_Height, m_Converted.data());
+
+            static constexpr char FRAME_TAG[] = "FRAME\n";
+            if (write(FRAME_TAG, sizeof(FRAME_TAG) - 1) && write(m_Converted.data(), m_Converted.size())) {
+                m_FrameCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            {
+                std::lock_guard lock(m_Mutex);
+                frame.Full = false;
+            }
+            m_FrameChanged.notify_all();
+            nextConvert ^= 1;
+        }
+
+        std::fflush(m_Output);
+    }
+
+    static std::vector<std::unique_ptr<FrameRecorder>> GFrameRecorderRegistry{};
+
+    FrameRecorder* createFrameRecorder(const FrameRecorderSpec& spec) {
+        auto recorder = std::make_unique<FrameRecorder>(spec);
+        if (!recorder->isOpen()) {
+            return nullptr;
+        }
+
+        return GFrameRecorderRegistry.emplace_back(std::move(recorder)).get();
+    }
+
+    void destroyFrameRecorder(FrameRecorder* recorder) {
+        auto iter = std::ranges::find_if(GFrameRecorderRegistry, [recorder](const std::unique_ptr<FrameRecorder>& r) { return r.get() == recorder; });
+        if (iter != GFrameRecorderRegistry.end()) {
+            GFrameRecorderRegistry.erase(iter);
+        }
+    }
+
+    void freeFrameRecorders() {
+        GFrameRecorderRegistry.clear();
+    }
+
+    void captureFrame(FrameRecorder* recorder, const gfx::FrameBuffer* fb, uint8_t attachmentIndex) {
+        recorder->capture(fb, attachmentIndex);
+    }
+
+    uint64_t getRecordedFrameCount(const FrameRecorder* recorder) {
+        return recorder->getFrameCount();
+    }
+} // namespace glass::capture
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "atomic"
+#include "condition_variable"
+#include "cstdio"
+#include "deque"
+#include "mutex"
+#include "string"
+#include "thread"
+
+namespace glass::capture {
+    class FrameRecorder {
+    public:
+        FrameRecorder(const FrameRecorderSpec& spec);
+        ~FrameRecorder();
+
+        FrameRecorder(const FrameRecorder&) = delete;
+        FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+        void capture(const gfx::FrameBuffer* fb, uint8_t attachmentIndex);
+
+        inline bool isOpen() const { return m_Output != nullptr; }
+        inline uint64_t getFrameCount() const { return m_FrameCount.load(std::memory_order_relaxed); }
+
+    private:
+        /** Hand the pixels of a finished readback to the worker thread */
+        void deliver(gfx::ReadbackTicket ticket);
+        void runWorker();
+        bool write(const void* data, size_t size);
+
+    private:
+        // Double buffered RGBA frames. The render thread fills one while the worker converts the other.
+        struct Frame {
+            std::vector<uint8_t> Pixels;
+            bool Full{};
+        };
+
+        FrameRecorderSpec m_Spec{};
+
+        /** Copy of the spec output, which only has to live until the recorder is created. m_Spec.Output points into it. */
+        std::string m_OutputPath;
+        FILE* m_Output{};
+        bool m_IsPipe{};
+
+        uint32_t m_Width{};
+        uint32_t m_Height{};
+        std::deque<gfx::ReadbackTicket> m_PendingReadbacks;
+
+        Frame m_Frames[2];
+        uint32_t m_NextFill{};
+        std::mutex m_Mutex;
+        std::condition_variable m_FrameChanged;
+        bool m_Stopping{};
+        std::thread m_Worker;
+
+        // Owned by the worker thread
+        std::vector<uint8_t> m_Converted;
+        bool m_WriteFailed{};
+        std::atomic<uint64_t> m_FrameCount{};
+    };
+
+    void freeFrameRecorders();
+} // namespace glass::capture
@@ -4,8 +4,13 @@
 #include "glInternal.h"
 
 #include "cassert"
+#include "algorithm"
+#include "vector"
 
 namespace glass::gfx {
+    // Vertex buffer binding of per instance data. Attributes set with glVertexAttribPointer use the binding of their own index.
+    static constexpr uint32_t INSTANCE_BUFFER_BINDING = 15;
+
     static uint16_t initAsVertexArray(const BufferSpec& spec, uint32_t bufferID) {
         uint32_t outID{};
         glGenVertexArrays(1, &outID);
@@ -15,8 +20,30 @@ namespace glass::gfx {
         if (spec.InputLayout && spec.StrideInBytes) {
             uint32_t attribID{};
             uint64_t totalOffset = 0;
+            uint32_t instanceOffset = 0;
             for (auto& elem : spec.InputLayout->getElements()) {
                 glEnableVertexAttribArray(attribID);
+                if (elem.DataRate == EBDR_PerInstance) {
+                    // Per instance elements are read from the buffer attached with bindInstanceBuffer
+                    switch (elem.Type) {
+                        case EVT_Float: {
+                            glVertexAttribFormat(attribID, static_cast<GLint>(elem.Count), GL_FLOAT, elem.Normalize, instanceOffset);
+                        } break;
+                        case EVT_Int: {
+                            glVertexAttribIFormat(attribID, static_cast<GLint>(elem.Count), GL_INT, instanceOffset);
+                        } break;
+                        case EVT_UInt: {
+                            glVertexAttribIFormat(attribID, static_cast<GLint>(elem.Count), GL_UNSIGNED_INT, instanceOffset);
+                        } break;
+                        default:
+                            break;
+                    }
+                    glVertexAttribBinding(attribID, INSTANCE_BUFFER_BINDING);
+                    attribID++;
+                    instanceOffset += static_cast<uint32_t>(sizeof(float) * elem.Count);
+                    continue;
+                }
+
                 switch (elem.Type) {
                     case EVT_Float: {
                         glVertexAttribPointer(attribID, static_cast<GLint>(elem.Count), GL_FLOAT, elem.Normalize, static_cast<GLsizei>(spec.StrideInBytes), (const void*)totalOffset);
@@ -33,6 +60,11 @@ namespace glass::gfx {
                 attribID++;
                 totalOffset += sizeof(float) * elem.Count;
             }
+
+            if (instanceOffset > 0) {
+                assert(attribID <= INSTANCE_BUFFER_BINDING && "Too many vertex attributes to keep a binding for instance data");
+                glVertexBindingDivisor(INSTANCE_BUFFER_BINDING, 1);
+            }
         } else {
             assert(false && "Did you forget to assign input layout or stride for vertex buffer?");
             return 0;
@@ -55,7 +87,16 @@ namespace glass::gfx {
         glBindBuffer(bufferType, handle.BufferID);
         if (spec.InitialData) {
             assert(spec.InitialDataSize > 0);
-            glBufferData(bufferType, static_cast<GLsizeiptr>(spec.InitialDataSize), spec.InitialData, toGLBufferUsage(spec.Usage, spec.Mutability));
+        }
+
+        // Allocate the whole buffer even if only a part of it (or nothing) is initialized, so it can be written later.
+        const uint64_t bufferSize = spec.SizeInBytes > spec.InitialDataSize ? spec.SizeInBytes : spec.InitialDataSize;
+        if (bufferSize > 0) {
+            const bool initializesWholeBuffer = spec.InitialData && spec.InitialDataSize == bufferSize;
+            glBufferData(bufferType, static_cast<GLsizeiptr>(bufferSize), initializesWholeBuffer ? spec.InitialData : nullptr, toGLBufferUsage(spec.Usage, spec.Mutability));
+            if (spec.InitialData && !initializesWholeBuffer) {
+                glBufferSubData(bufferType, 0, static_cast<GLsizeiptr>(spec.InitialDataSize), spec.InitialData);
+            }
         }
 
         glBindBuffer(bufferType, 0);
@@ -67,6 +108,97 @@ namespace glass::gfx {
         return static_cast<ResourceID>(handle.ID);
     }
 
+    struct StorageBinding {
+        uint32_t BufferID{};
+        uint64_t Offset{};
+        uint64_t Size{};
+    };
+
+    // The range is part of the binding, so binding another range of the same buffer is not skipped
+    static constexpr uint32_t MAX_CACHED_STORAGE_BINDINGS = 32;
+    static StorageBinding GStorageBindings[MAX_CACHED_STORAGE_BINDINGS]{};
+
+    void bindStorageBuffer(ResourceID buffer, uint32_t binding, uint64_t offset, uint64_t size) {
+        const uint32_t bufferID = getBufferID(buffer);
+        if (binding < MAX_CACHED_STORAGE_BINDINGS) {
+            StorageBinding& cached = GStorageBindings[binding];
+            if (cached.BufferID == bufferID && cached.Offset == offset && cached.Size == size) {
+                return;
+            }
+
+            cached = { bufferID, offset, size };
+        }
+
+        if (offset == 0 && size == 0) {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, bufferID);
+        } else {
+            assert(size > 0 && "Binding a range with an offset requires the range size");
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, bufferID, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+        }
+    }
+
+    static constexpr uint32_t MAX_CACHED_UNIFORM_BINDINGS = 32;
+    static uint32_t GUniformBindings[MAX_CACHED_UNIFORM_BINDINGS]{};
+
+    void resetBufferBindingCache() {
+        std::ranges::fill(GUniformBindings, 0u);
+        std::ranges::fill(GStorageBindings, StorageBinding{});
+    }
+
+    void bindUniformBufferBase(uint32_t binding, ResourceID buffer) {
+        const uint32_t bufferID = getBufferID(buffer);
+        if (binding < MAX_CACHED_UNIFORM_BINDINGS) {
+            if (GUniformBindings[binding] == bufferID) {
+                return;
+            }
+
+            GUniformBindings[binding] = bufferID;
+        }
+
+        glBindBufferBase(GL_UNIFORM_BUFFER, binding, bufferID);
+    }
+
+    void bindUniformBuffers(uint32_t firstBinding, std::span<const ResourceID> buffers) {
+        const BindBuffersBaseFn bindBuffersBaseMulti = getMultiBindFunctions().BindBuffersBase;
+        if (!bindBuffersBaseMulti) {
+            for (size_t i = 0; i < buffers.size(); ++i) {
+                bindUniformBufferBase(firstBinding + static_cast<uint32_t>(i), buffers[i]);
+            }
+            return;
+        }
+
+        static std::vector<GLuint> bufferIDs{};
+        bufferIDs.resize(buffers.size());
+
+        // Rebind the smallest range covering every changed binding
+        size_t first = buffers.size();
+        size_t last = 0;
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            const uint32_t binding = firstBinding + static_cast<uint32_t>(i);
+            bufferIDs[i] = getBufferID(buffers[i]);
+            if (binding < MAX_CACHED_UNIFORM_BINDINGS) {
+                if (GUniformBindings[binding] == bufferIDs[i]) {
+                    continue;
+                }
+
+                GUniformBindings[binding] = bufferIDs[i];
+            }
+
+            first = std::min(first, i);
+            last = i;
+        }
+
+        if (first < buffers.size()) {
+            bindBuffersBaseMulti(GL_UNIFORM_BUFFER, firstBinding + static_cast<GLuint>(first), static_cast<GLsizei>(last - first + 1), bufferIDs.data() + first);
+        }
+    }
+
+    void dispatchComputeIndirect(ResourceID buffer, uint64_t offset) {
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, getBufferID(buffer));
+        glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+    }
+
     void writeBufferData(ResourceID buffer, const void* data, uint64_t dataSize, uint64_t offset) {
         BufferHandle handle{buffer};
         const GLenum bufferType = toGLBufferType(handle.BufferType);
@@ -79,6 +211,18 @@ namespace glass::gfx {
     void destroyBuffer(ResourceID buffer) {
         BufferHandle handle{buffer};
 
+        // Deleted buffers are unbound from every binding point by GL.
+        for (StorageBinding& binding : GStorageBindings) {
+            if (binding.BufferID == handle.BufferID) {
+                binding = {};
+            }
+        }
+        for (uint32_t& binding : GUniformBindings) {
+            if (binding == handle.BufferID) {
+                binding = 0;
+            }
+        }
+
         if (handle.BufferType == EBT_Vertex) {
             uint32_t vao = handle.VAOID;
             glDeleteVertexArrays(1, &vao);
@@ -93,6 +237,14 @@ namespace glass::gfx {
         glBindVertexArray(handle.VAOID);
     }
 
+    void bindInstanceBuffer(ResourceID vertexBuffer, ResourceID instanceBuffer, uint64_t strideInBytes, uint64_t offset) {
+        assert(getBufferType(vertexBuffer) == EBT_Vertex && "Instance buffers are attached to vertex buffers");
+        assert(strideInBytes > 0);
+
+        glBindVertexArray(getVAOId(vertexBuffer));
+        glBindVertexBuffer(INSTANCE_BUFFER_BINDING, getBufferID(instanceBuffer), static_cast<GLintptr>(offset), static_cast<GLsizei>(strideInBytes));
+    }
+
     void bindElementBuffer(ResourceID buffer) {
         BufferHandle handle{buffer};
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, handle.BufferID);
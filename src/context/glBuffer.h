@@ -27,4 +27,10 @@ namespace glass::gfx {
         return BufferHandle(id).VAOID;
     }
 
+    /** Bind a whole buffer to a uniform block binding through the binding cache */
+    void bindUniformBufferBase(uint32_t binding, ResourceID buffer);
+
+    /** Forget the cached buffer bindings, which refer to objects of the destroyed context */
+    void resetBufferBindingCache();
+
 }
\ No newline at end of file
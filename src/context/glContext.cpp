@@ -7,6 +7,17 @@
 #include "ranges"
 #include "glShader.h"
 #include "glFrameBuffer.h"
+#include "glBuffer.h"
+#include "glInternal.h"
+#include "glDrawCuller.h"
+#include "glTexture.h"
+#include "glSampler.h"
+#include "glProgramCache.h"
+#include "glShaderBatch.h"
+#include "glShaderPreprocessor.h"
+#include "glProgramPipeline.h"
+#include "atlas/atlas.h"
+#include "capture/frameRecorder.h"
 
 #ifdef GLASS_ENABLE_HIGH_SEVERITY_CALLSTACK
     #include "stacktrace"
@@ -111,8 +122,22 @@ namespace glass::gfx {
 
     void shutdown() {
         GContextData.reset();
+        capture::freeFrameRecorders();
         freeFramebufferRegistry();
+        freeDrawCullerRegistry();
+        atlas::freeAtlasRegistry();
+        freeTextureStreaming();
+        freeTextureUploadRing();
+        freeReadbackRing();
+        freeSamplerCache();
+        resetTextureBindingCache();
+        resetBufferBindingCache();
+        resetMultiBindFunctions();
+        freeShaderCompileBatches();
+        freeProgramPipelines();
         terminateShaderLibrary();
+        freeShaderSourceCache();
+        freeProgramBinaryCache();
         GContextData = nullptr;
     }
 
@@ -308,49 +333,40 @@ namespace glass::gfx {
     }
 
     void draw(EPrimitiveTopology topology, uint32_t vertexCount, uint32_t firstVertex) {
-        GLenum glTop{};
-        switch (topology) {
-            case EPT_Triangles:
-                glTop = GL_TRIANGLES;
-                break;
-            case EPT_Lines:
-                glTop = GL_LINES;
-                break;
-            case EPT_Points:
-                glTop = GL_POINTS;
-                break;
-        }
-
-        glDrawArrays(glTop, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
+        glDrawArrays(toGLPrimitiveTopology(topology), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
     }
 
     void drawElements(EPrimitiveTopology topology, uint32_t indexCount, EIndexType indexType) {
-        GLenum glTop{};
-        switch (topology) {
-            case EPT_Triangles:
-                glTop = GL_TRIANGLES;
-                break;
-            case EPT_Lines:
-                glTop = GL_LINES;
-                break;
-            case EPT_Points:
-                glTop = GL_POINTS;
-                break;
-        }
+        glDrawElements(toGLPrimitiveTopology(topology), static_cast<GLsizei>(indexCount), toGLIndexType(indexType), nullptr);
+    }
 
-        GLenum glIndexType{};
-        switch (indexType) {
-            case EIT_UInt16:
-                glIndexType = GL_UNSIGNED_SHORT;
-                break;
-            case EIT_UInt32:
-                glIndexType = GL_UNSIGNED_INT;
-                break;
-            default:
-                break;
-        }
+    void drawInstanced(EPrimitiveTopology topology, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t baseInstance) {
+        glDrawArraysInstancedBaseInstance(toGLPrimitiveTopology(topology), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount), baseInstance);
+    }
+
+    void drawElementsInstanced(EPrimitiveTopology topology, uint32_t indexCount, uint32_t instanceCount, EIndexType indexType, uint32_t baseInstance) {
+        glDrawElementsInstancedBaseInstance(toGLPrimitiveTopology(topology), static_cast<GLsizei>(indexCount), toGLIndexType(indexType), nullptr, static_cast<GLsizei>(instanceCount), baseInstance);
+    }
+
+    void multiDrawElementsIndirect(EPrimitiveTopology topology, EIndexType indexType, ResourceID indirectBuffer, uint32_t drawCount, uint64_t offset) {
+        assert(getBufferType(indirectBuffer) == EBT_Indirect && "Indirect draws require a buffer of type EBT_Indirect");
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, getBufferID(indirectBuffer));
+        glMultiDrawElementsIndirect(
+            toGLPrimitiveTopology(topology),
+            toGLIndexType(indexType),
+            reinterpret_cast<const void*>(offset),
+            static_cast<GLsizei>(drawCount),
+            sizeof(DrawElementsIndirectCommand));
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    void dispatchCompute(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+        glDispatchCompute(groupCountX, groupCountY, groupCountZ);
+    }
 
-        glDrawElements(glTop, static_cast<GLsizei>(indexCount), glIndexType, nullptr);
+    void memoryBarrier(EMemoryBarrierMask barriers) {
+        glMemoryBarrier(toGLMemoryBarrierBits(barriers));
     }
 
     void setFrameBuffer(FrameBuffer* frameBuffer, bool updateViewport) {
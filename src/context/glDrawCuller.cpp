@@ -0,0 +1,256 @@
+#include "glDrawCuller.h"
+
+#include "glad/glad.h"
+#include "glBuffer.h"
+#include "glShader.h"
+#include "glInternal.h"
+
+#include "cassert"
+#include "iostream"
+#include "ranges"
+
+namespace glass::gfx {
+    static constexpr uint32_t CULL_GROUP_SIZE = 64;
+
+    static constexpr const char* DRAW_COMMAND_GLSL = R"(
+struct DrawCommand {
+    uint Count;
+    uint InstanceCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint BaseInstance;
+};
+)";
+
+    // Tests every object sphere against the frustum and appends commands of visible objects.
+    static constexpr const char* CULL_SHADER_SOURCE = R"(
+layout(local_size_x = 64) in;
+
+layout(std430, binding = 0) readonly buffer ObjectBounds {
+    vec4 Bounds[];
+};
+
+layout(std430, binding = 1) readonly buffer InputCommands {
+    DrawCommand InCommands[];
+};
+
+layout(std430, binding = 2) writeonly buffer OutputCommands {
+    DrawCommand OutCommands[];
+};
+
+layout(std430, binding = 3) buffer DrawCount {
+    uint VisibleCount;
+};
+
+uniform vec4 uFrustumPlanes[6];
+uniform uint uObjectCount;
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= uObjectCount) {
+        return;
+    }
+
+    vec4 sphere = Bounds[index];
+    for (int plane = 0; plane < 6; ++plane) {
+        if (dot(uFrustumPlanes[plane].xyz, sphere.xyz) + uFrustumPlanes[plane].w < -sphere.w) {
+            return;
+        }
+    }
+
+    DrawCommand command = InCommands[index];
+    if (command.InstanceCount == 0) {
+        return;
+    }
+
+    OutCommands[atomicAdd(VisibleCount, 1u)] = command;
+}
+)";
+
+    // Used when the draw count cannot be sourced from a buffer: turns the commands after the visible ones into empty draws.
+    static constexpr const char* CLEAR_TAIL_SHADER_SOURCE = R"(
+layout(local_size_x = 64) in;
+
+layout(std430, binding = 2) writeonly buffer OutputCommands {
+    DrawCommand OutCommands[];
+};
+
+layout(std430, binding = 3) readonly buffer DrawCount {
+    uint VisibleCount;
+};
+
+uniform uint uObjectCount;
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index < VisibleCount || index >= uObjectCount) {
+        return;
+    }
+
+    OutCommands[index] = DrawCommand(0u, 0u, 0u, 0, 0u);
+}
+)";
+
+    static const ShaderProgram* getOrCreateComputeProgram(const char* name, const char* body) {
+        const std::string source = std::format("#version 430 core\n{}{}", DRAW_COMMAND_GLSL, body);
+
+        ProgramSpec spec{};
+        spec.ComputeShader = getOrCreateShaderFromSource(name, source, EST_ComputeShader);
+        if (!spec.ComputeShader) {
+            return nullptr;
+        }
+
+        return getOrCreateShaderProgram(spec);
+    }
+
+    static std::vector<std::unique_ptr<DrawCuller>> GDrawCullerRegistry{};
+
+    DrawCuller::DrawCuller(const DrawCullerSpec& spec)
+        : m_Spec(spec) {
+        assert(getBufferType(spec.BoundsBuffer) == EBT_Storage && "Draw culler bounds must be stored in an EBT_Storage buffer");
+        assert(getBufferType(spec.CommandsBuffer) == EBT_Storage && "Draw culler commands must be stored in an EBT_Storage buffer");
+
+        m_CullProgram = getOrCreateComputeProgram("glass://drawCuller/cull.comp", CULL_SHADER_SOURCE);
+#if GLASS_CONTEXT_VERSION_MAJOR < 4 || GLASS_CONTEXT_VERSION_MINOR < 6
+        m_ClearTailProgram = getOrCreateComputeProgram("glass://drawCuller/clearTail.comp", CLEAR_TAIL_SHADER_SOURCE);
+        if (!m_ClearTailProgram) {
+            m_CullProgram = nullptr;
+        }
+#endif
+        if (!m_CullProgram) {
+            std::cout << std::format("GLASS error: Failed to create draw culler programs.");
+            return;
+        }
+
+        BufferSpec outputSpec{};
+        outputSpec.BufferType = EBT_Indirect;
+        outputSpec.Usage = EBU_Copy;
+        outputSpec.Mutability = EBM_Dynamic;
+        outputSpec.StrideInBytes = sizeof(DrawElementsIndirectCommand);
+        outputSpec.SizeInBytes = sizeof(DrawElementsIndirectCommand) * static_cast<uint64_t>(spec.MaxObjectCount);
+        m_OutputCommands = createBuffer(outputSpec);
+
+        const uint32_t zero = 0;
+        BufferSpec countSpec{};
+        countSpec.BufferType = EBT_Storage;
+        countSpec.Usage = EBU_Copy;
+        countSpec.Mutability = EBM_Dynamic;
+        countSpec.StrideInBytes = sizeof(uint32_t);
+        countSpec.SizeInBytes = sizeof(uint32_t);
+        countSpec.InitialData = &zero;
+        countSpec.InitialDataSize = sizeof(uint32_t);
+        m_DrawCount = createBuffer(countSpec);
+    }
+
+    DrawCuller::~DrawCuller() {
+        if (m_OutputCommands != ResourceID::Null) {
+            destroyBuffer(m_OutputCommands);
+        }
+
+        if (m_DrawCount != ResourceID::Null) {
+            destroyBuffer(m_DrawCount);
+        }
+    }
+
+    void DrawCuller::cull(const glm::mat4& viewProjection, uint32_t objectCount) {
+        using namespace hash::literals;
+
+        if (!isValid()) {
+            return;
+        }
+
+        m_LastObjectCount = std::min(objectCount, m_Spec.MaxObjectCount);
+        if (m_LastObjectCount == 0) {
+            return;
+        }
+
+        const cull::Frustum frustum = cull::extractFrustum(viewProjection);
+        const uint32_t groupCount = (m_LastObjectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE;
+
+        // Reset the visible counter on the GPU
+        const uint32_t zero = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, getBufferID(m_DrawCount));
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        bindStorageBuffer(m_Spec.BoundsBuffer, 0);
+        bindStorageBuffer(m_Spec.CommandsBuffer, 1);
+        bindStorageBuffer(m_OutputCommands, 2);
+        bindStorageBuffer(m_DrawCount, 3);
+
+        setUniform(m_CullProgram, "uFrustumPlanes"_hash, std::span<const glm::vec4>(frustum.Planes));
+        setUniform(m_CullProgram, "uObjectCount"_hash, m_LastObjectCount);
+
+        bindShaderProgram(m_CullProgram);
+        dispatchCompute(groupCount);
+
+        if (m_ClearTailProgram) {
+            memoryBarrier(EMBF_ShaderStorage);
+
+            setUniform(m_ClearTailProgram, "uObjectCount"_hash, m_LastObjectCount);
+            bindShaderProgram(m_ClearTailProgram);
+            dispatchCompute(groupCount);
+        }
+
+        memoryBarrier(EMBF_Command);
+    }
+
+    void DrawCuller::draw(EPrimitiveTopology topology, EIndexType indexType) const {
+        if (!isValid() || m_LastObjectCount == 0) {
+            return;
+        }
+
+#if GLASS_CONTEXT_VERSION_MAJOR >= 4 && GLASS_CONTEXT_VERSION_MINOR >= 6
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, getBufferID(m_OutputCommands));
+        glBindBuffer(GL_PARAMETER_BUFFER, getBufferID(m_DrawCount));
+        glMultiDrawElementsIndirectCount(
+            toGLPrimitiveTopology(topology),
+            toGLIndexType(indexType),
+            nullptr,
+            0,
+            static_cast<GLsizei>(m_LastObjectCount),
+            sizeof(DrawElementsIndirectCommand));
+        glBindBuffer(GL_PARAMETER_BUFFER, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+#else
+        // Commands past the visible count were cleared to empty draws by the tail pass.
+        multiDrawElementsIndirect(topology, indexType, m_OutputCommands, m_LastObjectCount);
+#endif
+    }
+
+    DrawCuller* createDrawCuller(const DrawCullerSpec& spec) {
+        auto culler = std::make_unique<DrawCuller>(spec);
+        if (!culler->isValid()) {
+            return nullptr;
+        }
+
+        return GDrawCullerRegistry.emplace_back(std::move(culler)).get();
+    }
+
+    void destroyDrawCuller(DrawCuller* culler) {
+        auto iter = std::ranges::find_if(GDrawCullerRegistry, [culler](const std::unique_ptr<DrawCuller>& c) { return c.get() == culler; });
+        if (iter != GDrawCullerRegistry.end()) {
+            GDrawCullerRegistry.erase(iter);
+        }
+    }
+
+    void freeDrawCullerRegistry() {
+        GDrawCullerRegistry.clear();
+    }
+
+    void cullDraws(DrawCuller* culler, const glm::mat4& viewProjection, uint32_t objectCount) {
+        culler->cull(viewProjection, objectCount);
+    }
+
+    void drawCulled(const DrawCuller* culler, EPrimitiveTopology topology, EIndexType indexType) {
+        culler->draw(topology, indexType);
+    }
+
+    ResourceID getDrawCullerCommandsBuffer(const DrawCuller* culler) {
+        return culler ? culler->getCommandsBuffer() : ResourceID::Null;
+    }
+
+    ResourceID getDrawCullerCountBuffer(const DrawCuller* culler) {
+        return culler ? culler->getCountBuffer() : ResourceID::Null;
+    }
+} // namespace glass::gfx
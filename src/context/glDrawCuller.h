@@ -0,0 +1,31 @@
+#pragma once
+
+#include "glass/glass.h"
+
+namespace glass::gfx {
+    class ShaderProgram;
+
+    class DrawCuller {
+    public:
+        DrawCuller(const DrawCullerSpec& spec);
+        ~DrawCuller();
+
+        void cull(const glm::mat4& viewProjection, uint32_t objectCount);
+        void draw(EPrimitiveTopology topology, EIndexType indexType) const;
+
+        inline bool isValid() const { return m_CullProgram != nullptr; }
+        inline ResourceID getCommandsBuffer() const { return m_OutputCommands; }
+        inline ResourceID getCountBuffer() const { return m_DrawCount; }
+
+    private:
+        DrawCullerSpec m_Spec{};
+        ResourceID m_OutputCommands{ ResourceID::Null };
+        ResourceID m_DrawCount{ ResourceID::Null };
+        uint32_t m_LastObjectCount{};
+
+        const ShaderProgram* m_CullProgram{};
+        const ShaderProgram* m_ClearTailProgram{};
+    };
+
+    void freeDrawCullerRegistry();
+} // namespace glass::gfx
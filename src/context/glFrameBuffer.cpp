@@ -2,8 +2,11 @@
 
 #include "glad/glad.h"
 #include "glTexture.h"
+#include "glStagingRing.h"
 
 #include "iostream"
+#include "algorithm"
+#include "memory"
 #include "glInternal.h"
 
 namespace glass::gfx {
@@ -157,6 +160,7 @@ namespace glass::gfx {
         switch (getTexturePixelFormat(texture)) {
             case EPF_RGB8:
             case EPF_RGBA8:
+            case EPF_SRGBA8:
             case EPF_R11G11B10F:
                 glClearBufferfv(GL_COLOR, attachmentIndex, glm::value_ptr(clearColor));
                 break;
@@ -185,4 +189,108 @@ namespace glass::gfx {
             dataType,
             outData));
     }
+
+    struct PendingReadback {
+        uint64_t Sequence{};
+        uint64_t Size{};
+    };
+
+    static std::unique_ptr<StagingRing> GReadbackRing{};
+    static PendingReadback GPendingReadbacks[MAX_PENDING_READBACKS]{};
+    static uint64_t GReadbackSequence = 0;
+
+    // Tickets hold the ring slot in the low byte and the sequence number of the read in the rest
+    static constexpr ReadbackTicket makeReadbackTicket(uint64_t sequence, uint32_t slot) {
+        return static_cast<ReadbackTicket>((sequence << 8) | slot);
+    }
+
+    // Slot of a ticket that still owns its ring slot, MAX_PENDING_READBACKS otherwise
+    static uint32_t getReadbackSlot(ReadbackTicket ticket) {
+        if (ticket == ReadbackTicket::Invalid || !GReadbackRing) {
+            return MAX_PENDING_READBACKS;
+        }
+
+        const uint64_t value = static_cast<uint64_t>(ticket);
+        const uint32_t slot = static_cast<uint32_t>(value & 0xff);
+        if (slot >= MAX_PENDING_READBACKS || GPendingReadbacks[slot].Sequence != value >> 8) {
+            return MAX_PENDING_READBACKS;
+        }
+
+        return slot;
+    }
+
+    ReadbackTicket readFramebufferAsync(const FrameBuffer* fb, uint8_t attachmentIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+        const auto texture = getFrameBufferColorAttachmentTexture(fb, attachmentIndex);
+        const auto format = getTexturePixelFormat(texture);
+        const uint64_t size = getImageSizeInBytes(format, static_cast<int32_t>(width), static_cast<int32_t>(height));
+        if (size == 0) {
+            return ReadbackTicket::Invalid;
+        }
+
+        if (!GReadbackRing) {
+            GReadbackRing = std::make_unique<StagingRing>(GL_PIXEL_PACK_BUFFER, MAX_PENDING_READBACKS);
+        }
+
+        const uint32_t slot = GReadbackRing->acquireSlot(size);
+        GPendingReadbacks[slot] = { ++GReadbackSequence, size };
+
+        // The context caches the bound framebuffer, so the read binding is restored for reads that rely on it
+        GLint previousReadFrameBuffer = 0;
+        GLCALL(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFrameBuffer));
+        GLCALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, fb->getId()));
+        GLCALL(glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex));
+        GLCALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+
+        // With a pixel pack buffer bound the pointer is an offset into the buffer
+        GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, GReadbackRing->getBufferID(slot)));
+        GLCALL(glReadPixels(
+            static_cast<GLint>(x),
+            static_cast<GLint>(y),
+            static_cast<GLsizei>(width),
+            static_cast<GLsizei>(height),
+            toGLFormat(format),
+            toGLDataTypeFromFormat(format),
+            nullptr));
+        GLCALL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        GLCALL(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+        GLCALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFrameBuffer)));
+
+        GReadbackRing->fenceSlot(slot);
+
+        // Make sure the fence reaches the GPU, otherwise polling it may never succeed
+        glFlush();
+        return makeReadbackTicket(GReadbackSequence, slot);
+    }
+
+    bool isReadbackReady(ReadbackTicket ticket) {
+        const uint32_t slot = getReadbackSlot(ticket);
+        return slot < MAX_PENDING_READBACKS && GReadbackRing->isSlotReady(slot);
+    }
+
+    uint64_t getReadbackSize(ReadbackTicket ticket) {
+        const uint32_t slot = getReadbackSlot(ticket);
+        return slot < MAX_PENDING_READBACKS ? GPendingReadbacks[slot].Size : 0;
+    }
+
+    const void* mapReadback(ReadbackTicket ticket) {
+        const uint32_t slot = getReadbackSlot(ticket);
+        if (slot == MAX_PENDING_READBACKS) {
+            return nullptr;
+        }
+
+        GReadbackRing->waitSlot(slot);
+        return GReadbackRing->mapSlotForRead(slot, GPendingReadbacks[slot].Size);
+    }
+
+    void unmapReadback(ReadbackTicket ticket) {
+        const uint32_t slot = getReadbackSlot(ticket);
+        if (slot < MAX_PENDING_READBACKS) {
+            GReadbackRing->unmapSlot(slot);
+        }
+    }
+
+    void freeReadbackRing() {
+        GReadbackRing.reset();
+        std::ranges::fill(GPendingReadbacks, PendingReadback{});
+    }
 } // namespace glass::gfx
\ No newline at end of file
@@ -41,4 +41,6 @@ namespace glass::gfx {
     };
 
     void freeFramebufferRegistry();
+
+    void freeReadbackRing();
 } // namespace glass::gfx
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "glInternal.h"
+
+#include "GLFW/glfw3.h"
+
+namespace glass::gfx {
+    static bool GMultiBindLoaded = false;
+    static MultiBindFunctions GMultiBind{};
+
+    const MultiBindFunctions& getMultiBindFunctions() {
+        if (GMultiBindLoaded) {
+            return GMultiBind;
+        }
+
+        GMultiBindLoaded = true;
+
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major * 100 + minor < 404 && !glfwExtensionSupported("GL_ARB_multi_bind")) {
+            return GMultiBind;
+        }
+
+        GMultiBind.BindTextures = reinterpret_cast<BindTexturesFn>(glfwGetProcAddress("glBindTextures"));
+        GMultiBind.BindBuffersBase = reinterpret_cast<BindBuffersBaseFn>(glfwGetProcAddress("glBindBuffersBase"));
+        return GMultiBind;
+    }
+
+    void resetMultiBindFunctions() {
+        GMultiBindLoaded = false;
+        GMultiBind = {};
+    }
+} // namespace glass::gfx
@@ -4,7 +4,31 @@
 
 #include "glad/glad.h"
 #include "type_traits"
-#include "hashHelpers.h"
+#include "glass/hashHelpers.h"
+
+// S3TC is an extension that is supported everywhere, but not part of core GL
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// Anisotropic filtering is core since 4.6 and available as EXT_texture_filter_anisotropic before that
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+    #define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#endif
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY
+    #define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+// KHR_parallel_shader_compile (and the identical ARB_parallel_shader_compile) is not part of core GL
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+    #define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 namespace glass::gfx {
     static constexpr GLenum toGLBufferType(EBufferType type) {
@@ -19,6 +43,8 @@ namespace glass::gfx {
                 return GL_UNIFORM_BUFFER;
             case EBT_Storage:
                 return GL_SHADER_STORAGE_BUFFER;
+            case EBT_Indirect:
+                return GL_DRAW_INDIRECT_BUFFER;
         }
 
         return 0;
@@ -84,6 +110,27 @@ namespace glass::gfx {
         return 0;
     }
 
+    static constexpr GLbitfield toGLShaderStageBit(EShaderType type) {
+        switch (type) {
+            case EST_VertexShader:
+                return GL_VERTEX_SHADER_BIT;
+            case EST_FragmentShader:
+                return GL_FRAGMENT_SHADER_BIT;
+#if GLASS_CONTEXT_VERSION_MAJOR >= 4 && GLASS_CONTEXT_VERSION_MINOR >= 3
+            case EST_ComputeShader:
+                return GL_COMPUTE_SHADER_BIT;
+#endif
+            case EST_GeometryShader:
+                return GL_GEOMETRY_SHADER_BIT;
+            case EST_TesellationControlShader:
+                return GL_TESS_CONTROL_SHADER_BIT;
+            case EST_TesellationEvaluationShader:
+                return GL_TESS_EVALUATION_SHADER_BIT;
+        }
+
+        return 0;
+    }
+
     static constexpr GLenum toGLTextureType(ETextureType type) {
         switch (type) {
             case ETT_Texture1D:
@@ -98,6 +145,9 @@ namespace glass::gfx {
             case ETT_TextureCube:
                 return GL_TEXTURE_CUBE_MAP;
                 break;
+            case ETT_Texture2DArray:
+                return GL_TEXTURE_2D_ARRAY;
+                break;
         }
 
         return 0;
@@ -109,6 +159,7 @@ namespace glass::gfx {
                 return GL_INT;
             case EPF_RGB8:
             case EPF_RGBA8:
+            case EPF_SRGBA8:
             case EPF_R11G11B10F:
                 return GL_UNSIGNED_BYTE;
             case EPF_DepthStencil:
@@ -123,6 +174,7 @@ namespace glass::gfx {
             case EPF_RGB8:
                 return GL_RGB;
             case EPF_RGBA8:
+            case EPF_SRGBA8:
                 return GL_RGBA;
             case EPF_R11G11B10F:
                 return GL_RGB;
@@ -140,18 +192,78 @@ namespace glass::gfx {
             case EPF_RedInteger:
                 return GL_R32I;
             case EPF_RGB8:
-                return GL_RGB;
+                return GL_RGB8;
             case EPF_RGBA8:
                 return GL_RGBA8;
+            case EPF_SRGBA8:
+                return GL_SRGB8_ALPHA8;
             case EPF_R11G11B10F:
                 return GL_R11F_G11F_B10F;
             case EPF_DepthStencil:
                 return GL_DEPTH24_STENCIL8;
+            case EPF_BC1:
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case EPF_BC3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case EPF_BC4:
+                return GL_COMPRESSED_RED_RGTC1;
+            case EPF_BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            case EPF_BC7:
+                return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            case EPF_ETC2_RGB8:
+                return GL_COMPRESSED_RGB8_ETC2;
+            case EPF_ETC2_RGBA8:
+                return GL_COMPRESSED_RGBA8_ETC2_EAC;
         }
 
         return 0;
     }
 
+    /** Size in bytes of a 4x4 block of a compressed format, 0 for uncompressed formats */
+    static constexpr uint32_t getCompressedBlockSize(EPixelFormat format) {
+        switch (format) {
+            case EPF_BC1:
+            case EPF_BC4:
+            case EPF_ETC2_RGB8:
+                return 8;
+            case EPF_BC3:
+            case EPF_BC5:
+            case EPF_BC7:
+            case EPF_ETC2_RGBA8:
+                return 16;
+        }
+
+        return 0;
+    }
+
+    /** Size in bytes of a single pixel as it is passed to and from GL. 0 for compressed formats. */
+    static constexpr uint32_t getPixelFormatSize(EPixelFormat format) {
+        switch (format) {
+            case EPF_RGB8:
+            case EPF_R11G11B10F:
+                return 3;
+            case EPF_RGBA8:
+            case EPF_SRGBA8:
+            case EPF_RedInteger:
+            case EPF_DepthStencil:
+                return 4;
+        }
+
+        return 0;
+    }
+
+    /** Size in bytes of a tightly packed image region. Compressed formats are rounded up to whole blocks. */
+    static constexpr uint64_t getImageSizeInBytes(EPixelFormat format, int32_t width, int32_t height, int32_t depth = 1) {
+        if (const uint64_t blockSize = getCompressedBlockSize(format)) {
+            const uint64_t blocksX = (static_cast<uint64_t>(width) + 3) / 4;
+            const uint64_t blocksY = (static_cast<uint64_t>(height) + 3) / 4;
+            return blocksX * blocksY * depth * blockSize;
+        }
+
+        return static_cast<uint64_t>(width) * height * depth * getPixelFormatSize(format);
+    }
+
     static constexpr GLenum toGLWrapMode(ETextureWrapMode wrapMode) {
         switch (wrapMode) {
             case ETWM_Repeat:
@@ -180,6 +292,132 @@ namespace glass::gfx {
         return 0;
     }
 
+    static constexpr GLenum toGLMinFilter(ETextureFilter filter, ETextureMipFilter mipFilter) {
+        switch (mipFilter) {
+            case ETMF_None:
+                return toGLFilter(filter);
+            case ETMF_Nearest:
+                return filter == ETF_Linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+            case ETMF_Linear:
+                return filter == ETF_Linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+        }
+        return 0;
+    }
+
+    static constexpr GLenum toGLCompareFunc(ECompareFunc func) {
+        switch (func) {
+            case ECF_Never:
+                return GL_NEVER;
+            case ECF_Less:
+                return GL_LESS;
+            case ECF_Equal:
+                return GL_EQUAL;
+            case ECF_LessEqual:
+                return GL_LEQUAL;
+            case ECF_Greater:
+                return GL_GREATER;
+            case ECF_NotEqual:
+                return GL_NOTEQUAL;
+            case ECF_GreaterEqual:
+                return GL_GEQUAL;
+            case ECF_Always:
+                return GL_ALWAYS;
+        }
+        return 0;
+    }
+
+    static constexpr GLenum toGLPrimitiveTopology(EPrimitiveTopology topology) {
+        switch (topology) {
+            case EPT_Triangles:
+                return GL_TRIANGLES;
+            case EPT_Lines:
+                return GL_LINES;
+            case EPT_Points:
+                return GL_POINTS;
+        }
+        return 0;
+    }
+
+    static constexpr GLenum toGLIndexType(EIndexType indexType) {
+        switch (indexType) {
+            case EIT_UInt16:
+                return GL_UNSIGNED_SHORT;
+            case EIT_UInt32:
+                return GL_UNSIGNED_INT;
+        }
+        return 0;
+    }
+
+    static constexpr GLbitfield toGLMemoryBarrierBits(EMemoryBarrierMask barriers) {
+        if ((barriers & EMBF_All) == EMBF_All) {
+            return GL_ALL_BARRIER_BITS;
+        }
+
+        GLbitfield bits{};
+        if (barriers & EMBF_VertexAttribArray) {
+            bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+        }
+        if (barriers & EMBF_ElementArray) {
+            bits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+        }
+        if (barriers & EMBF_Uniform) {
+            bits |= GL_UNIFORM_BARRIER_BIT;
+        }
+        if (barriers & EMBF_TextureFetch) {
+            bits |= GL_TEXTURE_FETCH_BARRIER_BIT;
+        }
+        if (barriers & EMBF_ShaderImageAccess) {
+            bits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        }
+        if (barriers & EMBF_Command) {
+            bits |= GL_COMMAND_BARRIER_BIT;
+        }
+        if (barriers & EMBF_PixelBuffer) {
+            bits |= GL_PIXEL_BUFFER_BARRIER_BIT;
+        }
+        if (barriers & EMBF_TextureUpdate) {
+            bits |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+        }
+        if (barriers & EMBF_BufferUpdate) {
+            bits |= GL_BUFFER_UPDATE_BARRIER_BIT;
+        }
+        if (barriers & EMBF_Framebuffer) {
+            bits |= GL_FRAMEBUFFER_BARRIER_BIT;
+        }
+        if (barriers & EMBF_AtomicCounter) {
+            bits |= GL_ATOMIC_COUNTER_BARRIER_BIT;
+        }
+        if (barriers & EMBF_ShaderStorage) {
+            bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+        }
+        return bits;
+    }
+
+    static constexpr GLenum toGLImageAccess(EImageAccess access) {
+        switch (access) {
+            case EIA_ReadOnly:
+                return GL_READ_ONLY;
+            case EIA_WriteOnly:
+                return GL_WRITE_ONLY;
+            case EIA_ReadWrite:
+                return GL_READ_WRITE;
+        }
+        return 0;
+    }
+
+    using BindTexturesFn = void (APIENTRYP)(GLuint first, GLsizei count, const GLuint* textures);
+    using BindBuffersBaseFn = void (APIENTRYP)(GLenum target, GLuint first, GLsizei count, const GLuint* buffers);
+
+    /** ARB_multi_bind (core since 4.4) entry points, null if the driver lacks them */
+    struct MultiBindFunctions {
+        BindTexturesFn BindTextures{};
+        BindBuffersBaseFn BindBuffersBase{};
+    };
+
+    /** Loaded at runtime on first use, so builds for older context versions still use multi-bind when the driver has it */
+    const MultiBindFunctions& getMultiBindFunctions();
+    void resetMultiBindFunctions();
+
     static void clearErrors() {
         while (glGetError())
             ;
@@ -0,0 +1,194 @@
+#include "glProgramCache.h"
+#include "glInternal.h"
+#include "io/mappedFile.h"
+
+#include "iostream"
+#include "filesystem"
+#include "fstream"
+#include "memory"
+#include "cstring"
+
+namespace glass::gfx {
+    static constexpr uint32_t PROGRAM_BINARY_MAGIC = 0x42504c47; // "GLPB"
+
+    /** Bump when the file layout or the key calculation changes */
+    static constexpr uint32_t PROGRAM_BINARY_VERSION = 1;
+
+    struct ProgramBinaryHeader {
+        uint32_t Magic{ PROGRAM_BINARY_MAGIC };
+        uint32_t Version{ PROGRAM_BINARY_VERSION };
+        uint64_t DriverHash{};
+        uint64_t Key{};
+        uint32_t Format{};
+        uint32_t Size{};
+    };
+
+    struct ProgramBinaryCache {
+        std::filesystem::path Directory;
+
+        /** Hash of the vendor, renderer and version strings. Binaries of other drivers are never loaded. */
+        uint64_t DriverHash{};
+        ProgramBinaryCacheStats Stats{};
+    };
+
+    static std::unique_ptr<ProgramBinaryCache> GProgramBinaryCache{};
+
+    static uint64_t calculateDriverHash() {
+        const auto getString = [](GLenum name) {
+            const GLubyte* value = glGetString(name);
+            return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+        };
+
+        const std::string driver = std::format("{}\n{}\n{}\n{}", getString(GL_VENDOR), getString(GL_RENDERER), getString(GL_VERSION), PROGRAM_BINARY_VERSION);
+        return hash::hash64(driver.data(), driver.size());
+    }
+
+    static std::filesystem::path getProgramBinaryPath(uint64_t key) {
+        return GProgramBinaryCache->Directory / std::format("{:016x}.bin", key);
+    }
+
+    static bool readProgramBinaryHeader(const std::filesystem::path& path, ProgramBinaryHeader& outHeader) {
+        std::ifstream file(path, std::ios::binary);
+        return file.read(reinterpret_cast<char*>(&outHeader), sizeof(outHeader)) && outHeader.Magic == PROGRAM_BINARY_MAGIC;
+    }
+
+    // Binaries of a previous driver can never be loaded again. Temporary files are left over by writes that were interrupted.
+    static void removeStaleProgramBinaries() {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(GProgramBinaryCache->Directory, error)) {
+            if (entry.path().extension() == ".tmp") {
+                std::filesystem::remove(entry.path(), error);
+                continue;
+            }
+
+            if (entry.path().extension() != ".bin") {
+                continue;
+            }
+
+            ProgramBinaryHeader header{};
+            if (!readProgramBinaryHeader(entry.path(), header) || header.Version != PROGRAM_BINARY_VERSION || header.DriverHash != GProgramBinaryCache->DriverHash) {
+                std::filesystem::remove(entry.path(), error);
+            }
+        }
+    }
+
+    bool enableProgramBinaryCache(const std::string& directory) {
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if (formatCount == 0) {
+            std::cout << std::format("GLASS warning: The driver supports no program binary formats, programs will not be cached.");
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            std::cout << std::format("GLASS error: Failed to create the program binary cache directory {}: {}", directory, error.message());
+            return false;
+        }
+
+        GProgramBinaryCache = std::make_unique<ProgramBinaryCache>();
+        GProgramBinaryCache->Directory = directory;
+        GProgramBinaryCache->DriverHash = calculateDriverHash();
+        removeStaleProgramBinaries();
+        return true;
+    }
+
+    void disableProgramBinaryCache() {
+        GProgramBinaryCache.reset();
+    }
+
+    ProgramBinaryCacheStats getProgramBinaryCacheStats() {
+        return GProgramBinaryCache ? GProgramBinaryCache->Stats : ProgramBinaryCacheStats{};
+    }
+
+    bool isProgramBinaryCacheEnabled() {
+        return GProgramBinaryCache != nullptr;
+    }
+
+    bool loadProgramBinary(uint32_t program, uint64_t key) {
+        const std::filesystem::path path = getProgramBinaryPath(key);
+        bool loaded = false;
+        {
+            const io::MappedFile file(path.string());
+            if (!file.isOpen()) {
+                ++GProgramBinaryCache->Stats.Misses;
+                return false;
+            }
+
+            ProgramBinaryHeader header{};
+            if (file.getSize() >= sizeof(header)) {
+                std::memcpy(&header, file.getData(), sizeof(header));
+            }
+
+            const bool valid = header.Magic == PROGRAM_BINARY_MAGIC && header.Version == PROGRAM_BINARY_VERSION && header.DriverHash == GProgramBinaryCache->DriverHash && header.Key == key && file.getSize() == sizeof(header) + header.Size;
+            if (valid) {
+                glProgramBinary(program, header.Format, file.getData() + sizeof(header), static_cast<GLsizei>(header.Size));
+
+                GLint linkStatus = GL_FALSE;
+                glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+                loaded = linkStatus == GL_TRUE;
+            }
+        }
+
+        if (!loaded) {
+            // Drivers may reject their own binaries (e.g. after an update that kept the version string), compile from source instead
+            ++GProgramBinaryCache->Stats.Rejected;
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            return false;
+        }
+
+        ++GProgramBinaryCache->Stats.Hits;
+        return true;
+    }
+
+    void storeProgramBinary(uint32_t program, uint64_t key) {
+        GLint size = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+        if (size <= 0) {
+            return;
+        }
+
+        ProgramBinaryHeader header{};
+        header.DriverHash = GProgramBinaryCache->DriverHash;
+        header.Key = key;
+
+        std::vector<uint8_t> binary(static_cast<size_t>(size));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, size, &written, &format, binary.data());
+        header.Format = format;
+        header.Size = static_cast<uint32_t>(written);
+
+        // Written next to the final file and renamed, so an interrupted write never leaves a truncated binary behind
+        const std::filesystem::path path = getProgramBinaryPath(key);
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data()), written);
+
+        // Closed before checking, since buffered data is only flushed to disk now
+        file.close();
+
+        std::error_code error;
+        if (!file) {
+            std::cout << std::format("GLASS warning: Failed to write program binary {}", temporaryPath.string());
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error) {
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+
+        ++GProgramBinaryCache->Stats.Stores;
+    }
+
+    void freeProgramBinaryCache() {
+        GProgramBinaryCache.reset();
+    }
+} // namespace glass::gfx
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "glass/glass.h"
+
+namespace glass::gfx {
+    bool isProgramBinaryCacheEnabled();
+
+    /**
+     * Load a program binary stored under the key into program.
+     * @return true if the program is linked from the binary. Rejected binaries are removed from the cache.
+     */
+    bool loadProgramBinary(uint32_t program, uint64_t key);
+
+    /** Store the binary of a linked program. The program must be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT. */
+    void storeProgramBinary(uint32_t program, uint64_t key);
+
+    void freeProgramBinaryCache();
+} // namespace glass::gfx
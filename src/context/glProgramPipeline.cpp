@@ -0,0 +1,85 @@
+#include "glProgramPipeline.h"
+#include "glShader.h"
+#include "glInternal.h"
+
+#include "array"
+#include "memory"
+#include "unordered_map"
+
+namespace glass::gfx {
+    using ProgramPipelineStages = std::array<Shader*, 6>;
+
+    struct ProgramPipelineStagesHash {
+        size_t operator()(const ProgramPipelineStages& shaders) const {
+            uint64_t pipelineHash = 0x919e;
+            for (const Shader* shader : shaders) {
+                hash::hashCombine(pipelineHash, shader);
+            }
+            return static_cast<size_t>(pipelineHash);
+        }
+    };
+
+    // Keyed by the stages themselves, so pipelines whose hashes collide are still told apart
+    static std::unordered_map<ProgramPipelineStages, std::unique_ptr<ProgramPipeline>, ProgramPipelineStagesHash> GProgramPipelines{};
+
+    ProgramPipeline::ProgramPipeline(uint32_t id, const std::array<ShaderProgram*, 6>& stages)
+        : m_Id(id)
+        , m_Stages(stages) {
+    }
+
+    ProgramPipeline::~ProgramPipeline() {
+        if (m_Id) {
+            glDeleteProgramPipelines(1, &m_Id);
+        }
+    }
+
+    ProgramPipeline* getOrCreateProgramPipeline(const ProgramSpec& spec) {
+        const ProgramPipelineStages shaders = { spec.VertexShader, spec.FragmentShader, spec.ComputeShader, spec.GeometryShader, spec.TesellationControlShader, spec.TesellationEvaluationShader };
+        if (const auto iter = GProgramPipelines.find(shaders); iter != GProgramPipelines.end()) {
+            return iter->second.get();
+        }
+
+        if (!validateProgramSpec(spec)) {
+            return nullptr;
+        }
+
+        // Stage programs are shared by every pipeline using the shader, so each stage links once
+        std::array<ShaderProgram*, 6> stages{};
+        for (Shader* shader : shaders) {
+            if (!shader) {
+                continue;
+            }
+
+            ShaderProgram* stage = getOrCreateSeparableProgram(shader);
+            if (!stage) {
+                return nullptr;
+            }
+
+            stages[shader->getType()] = stage;
+        }
+
+        uint32_t pipeline{};
+        glGenProgramPipelines(1, &pipeline);
+        for (uint32_t type = 0; type < stages.size(); ++type) {
+            if (stages[type]) {
+                glUseProgramStages(pipeline, toGLShaderStageBit(static_cast<EShaderType>(type)), stages[type]->getId());
+            }
+        }
+
+        return GProgramPipelines.emplace(shaders, std::make_unique<ProgramPipeline>(pipeline, stages)).first->second.get();
+    }
+
+    ShaderProgram* getProgramPipelineStage(const ProgramPipeline* pipeline, EShaderType type) {
+        return pipeline->getStage(type);
+    }
+
+    void bindProgramPipeline(const ProgramPipeline* pipeline) {
+        // A program bound with glUseProgram takes precedence over the bound pipeline
+        glUseProgram(0);
+        glBindProgramPipeline(pipeline->getId());
+    }
+
+    void freeProgramPipelines() {
+        GProgramPipelines.clear();
+    }
+} // namespace glass::gfx
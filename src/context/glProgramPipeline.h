@@ -0,0 +1,25 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "array"
+
+namespace glass::gfx {
+    class ProgramPipeline {
+    public:
+        /** @param stages Separable programs indexed by EShaderType */
+        ProgramPipeline(uint32_t id, const std::array<ShaderProgram*, 6>& stages);
+        ~ProgramPipeline();
+
+        ProgramPipeline(const ProgramPipeline&) = delete;
+        ProgramPipeline& operator=(const ProgramPipeline&) = delete;
+
+        inline uint32_t getId() const { return m_Id; }
+        inline ShaderProgram* getStage(EShaderType type) const { return m_Stages[type]; }
+
+    private:
+        uint32_t m_Id{};
+        std::array<ShaderProgram*, 6> m_Stages{};
+    };
+
+    void freeProgramPipelines();
+} // namespace glass::gfx
@@ -0,0 +1,89 @@
+#include "glSampler.h"
+#include "unordered_map"
+
+namespace glass::gfx {
+    static std::unordered_map<uint64_t, uint32_t> GSamplerCache{};
+
+    // Samplers bound to texture units, tracked apart from the textures bound to the same units
+    static constexpr uint32_t MAX_CACHED_SAMPLER_UNITS = 32;
+    static uint32_t GBoundSamplers[MAX_CACHED_SAMPLER_UNITS]{};
+
+    // 0 until queried
+    static float GMaxAnisotropy = 0.0f;
+
+    float getMaxSupportedAnisotropy() {
+        if (GMaxAnisotropy == 0.0f) {
+            GMaxAnisotropy = 1.0f;
+
+            // Without the extension the query fails and leaves the value untouched
+            clearErrors();
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &GMaxAnisotropy);
+            if (glGetError() != GL_NO_ERROR) {
+                GMaxAnisotropy = 1.0f;
+            }
+        }
+
+        return GMaxAnisotropy;
+    }
+
+    static uint64_t calculateSamplerHash(const SamplerSpec& spec) {
+        uint64_t specHash = 0x5a3b1e;
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.MinFilter));
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.MagFilter));
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.MipFilter));
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.WrapModeS));
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.WrapModeT));
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.WrapModeU));
+        hash::hashCombine(specHash, spec.MaxAnisotropy);
+        hash::hashCombine(specHash, spec.LodBias);
+        hash::hashCombine(specHash, spec.MinLod);
+        hash::hashCombine(specHash, spec.MaxLod);
+        hash::hashCombine(specHash, spec.CompareEnabled);
+        hash::hashCombine(specHash, static_cast<int32_t>(spec.CompareFunc));
+        return specHash;
+    }
+
+    ResourceID getOrCreateSampler(const SamplerSpec& spec) {
+        const uint64_t specHash = calculateSamplerHash(spec);
+        if (const auto iter = GSamplerCache.find(specHash); iter != GSamplerCache.end()) {
+            return static_cast<ResourceID>(iter->second);
+        }
+
+        uint32_t sampler = 0;
+        GLCALL(glGenSamplers(1, &sampler));
+        applySamplerSpec(
+            spec,
+            [sampler](GLenum parameter, GLint value) { GLCALL(glSamplerParameteri(sampler, parameter, value)); },
+            [sampler](GLenum parameter, GLfloat value) { GLCALL(glSamplerParameterf(sampler, parameter, value)); });
+
+        GSamplerCache[specHash] = sampler;
+        return static_cast<ResourceID>(sampler);
+    }
+
+    uint32_t getOpenGLSamplerID(ResourceID sampler) {
+        return static_cast<uint32_t>(sampler);
+    }
+
+    void bindSampler(uint32_t unit, ResourceID sampler) {
+        const uint32_t samplerID = getOpenGLSamplerID(sampler);
+        if (unit < MAX_CACHED_SAMPLER_UNITS) {
+            if (GBoundSamplers[unit] == samplerID) {
+                return;
+            }
+
+            GBoundSamplers[unit] = samplerID;
+        }
+
+        GLCALL(glBindSampler(unit, samplerID));
+    }
+
+    void freeSamplerCache() {
+        for (const auto& [hash, sampler] : GSamplerCache) {
+            glDeleteSamplers(1, &sampler);
+        }
+
+        GSamplerCache.clear();
+        std::ranges::fill(GBoundSamplers, 0u);
+        GMaxAnisotropy = 0.0f;
+    }
+} // namespace glass::gfx
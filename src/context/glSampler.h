@@ -0,0 +1,41 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "glInternal.h"
+#include "algorithm"
+
+namespace glass::gfx {
+    /** Largest anisotropy supported by the driver, 1 if anisotropic filtering is unavailable */
+    float getMaxSupportedAnisotropy();
+
+    /**
+     * Apply the sampling parameters of a spec. Shared by sampler objects and the per-texture parameters of createTexture.
+     * setInt and setFloat take (GLenum parameter, value) and forward to glSamplerParameter* or glTexParameter*.
+     */
+    template <typename SetInt, typename SetFloat>
+    void applySamplerSpec(const SamplerSpec& spec, SetInt&& setInt, SetFloat&& setFloat) {
+        setInt(GL_TEXTURE_MIN_FILTER, toGLMinFilter(spec.MinFilter, spec.MipFilter));
+        setInt(GL_TEXTURE_MAG_FILTER, toGLFilter(spec.MagFilter));
+        setInt(GL_TEXTURE_WRAP_S, toGLWrapMode(spec.WrapModeS));
+        setInt(GL_TEXTURE_WRAP_T, toGLWrapMode(spec.WrapModeT));
+        setInt(GL_TEXTURE_WRAP_R, toGLWrapMode(spec.WrapModeU));
+
+        setFloat(GL_TEXTURE_LOD_BIAS, spec.LodBias);
+        setFloat(GL_TEXTURE_MIN_LOD, spec.MinLod);
+        setFloat(GL_TEXTURE_MAX_LOD, spec.MaxLod);
+
+        if (spec.MaxAnisotropy > 1.0f) {
+            const float maxAnisotropy = getMaxSupportedAnisotropy();
+            if (maxAnisotropy > 1.0f) {
+                setFloat(GL_TEXTURE_MAX_ANISOTROPY, std::min(spec.MaxAnisotropy, maxAnisotropy));
+            }
+        }
+
+        if (spec.CompareEnabled) {
+            setInt(GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            setInt(GL_TEXTURE_COMPARE_FUNC, toGLCompareFunc(spec.CompareFunc));
+        }
+    }
+
+    void freeSamplerCache();
+} // namespace glass::gfx
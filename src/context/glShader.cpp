@@ -4,43 +4,40 @@
 #include "glShader.h"
 #include "glInternal.h"
 
-#include "fstream"
-#include "sstream"
 #include "iostream"
 #include "cassert"
 #include "vector"
+#include "algorithm"
 #include "glTexture.h"
 #include "glBuffer.h"
+#include "glProgramCache.h"
+#include "glShaderPreprocessor.h"
 
 namespace glass::gfx {
-    static std::string readShaderSource(const std::string& path) {
-        std::ifstream shaderSource{ path };
-        assert(shaderSource.is_open());
-
-        std::stringstream source;
-        source << shaderSource.rdbuf();
-        return source.str();
-    }
-
     struct ShaderRegistry {
-        std::unordered_map<std::string, std::shared_ptr<Shader>> Shaders;
+        /** Keyed by the path (or name) combined with the define set */
+        std::unordered_map<uint64_t, std::shared_ptr<Shader>> Shaders;
         std::unordered_map<uint64_t, std::shared_ptr<ShaderProgram>> Programs;
+
+        /** Process wide uniform block bindings keyed by the block name hash */
+        std::unordered_map<uint64_t, uint32_t> BlockBindings;
+
+        /** Whether a block name owns the binding, indexed by binding */
+        std::vector<bool> TakenBlockBindings;
     };
 
     static std::unique_ptr<ShaderRegistry> GShaderRegistry = std::make_unique<ShaderRegistry>();
 
-    Shader* getOrCreateShader(const std::string& path, EShaderType type) {
-        if (GShaderRegistry->Shaders.contains(path)) {
-            return GShaderRegistry->Shaders.at(path).get();
-        }
-
-        std::string source = readShaderSource(path);
+    static uint32_t startShaderCompile(const std::string& source, EShaderType type) {
         const char* csource = source.c_str();
 
         uint32_t shader = glCreateShader(toGLShaderType(type));
         glShaderSource(shader, 1, &csource, nullptr);
         glCompileShader(shader);
+        return shader;
+    }
 
+    static uint32_t finishShaderCompile(uint32_t shader) {
         int status;
         glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
 
@@ -52,17 +49,100 @@ namespace glass::gfx {
             glGetShaderInfoLog(shader, len, &len, logInfo.data());
 
             std::cout << std::format("GLASS: Failed to compile shader: {}", logInfo);
-            return nullptr;
+            glDeleteShader(shader);
+            return 0;
+        }
+
+        return shader;
+    }
+
+    static uint32_t compileShader(const std::string& source, EShaderType type) {
+        return finishShaderCompile(startShaderCompile(source, type));
+    }
+
+    static uint64_t calculateShaderKey(const std::string& path, std::span<const ShaderDefine> defines) {
+        uint64_t key = calculateShaderDefinesHash(defines);
+        hash::hashCombine(key, path);
+        return key;
+    }
+
+    static Shader* findShader(uint64_t key) {
+        const auto iter = GShaderRegistry->Shaders.find(key);
+        return iter != GShaderRegistry->Shaders.end() ? iter->second.get() : nullptr;
+    }
+
+    static Shader* registerShader(uint64_t key, std::string source, EShaderType type, bool deferCompilation) {
+        const uint64_t sourceHash = hash::hash64(source.data(), source.size());
+        std::vector<uint64_t> explicitBlockBindings = findExplicitBlockBindings(source);
+        std::shared_ptr<Shader> outShader{};
+        if (deferCompilation) {
+            outShader = std::make_shared<Shader>(std::move(source), type, sourceHash, std::move(explicitBlockBindings));
+        } else {
+            const uint32_t shader = compileShader(source, type);
+            if (!shader) {
+                return nullptr;
+            }
+
+            outShader = std::make_shared<Shader>(shader, type, sourceHash, std::move(explicitBlockBindings));
         }
 
-        std::shared_ptr<Shader> outShader = std::make_shared<Shader>(shader, type);
-        GShaderRegistry->Shaders[path] = outShader;
+        GShaderRegistry->Shaders[key] = outShader;
         return outShader.get();
     }
 
-    Shader::Shader(uint32_t shader, EShaderType type)
+    Shader* getOrCreateShader(const std::string& path, EShaderType type) {
+        return getOrCreateShader(path, type, {});
+    }
+
+    Shader* getOrCreateShader(const std::string& path, EShaderType type, std::span<const ShaderDefine> defines) {
+        const uint64_t key = calculateShaderKey(path, defines);
+        if (Shader* existing = findShader(key)) {
+            return existing;
+        }
+
+        std::optional<std::string> source = preprocessShaderSource(path, defines);
+        if (!source) {
+            return nullptr;
+        }
+
+        return registerShader(key, std::move(*source), type, isProgramBinaryCacheEnabled());
+    }
+
+    Shader* getOrCreateDeferredShader(const std::string& path, EShaderType type, std::span<const ShaderDefine> defines) {
+        const uint64_t key = calculateShaderKey(path, defines);
+        if (Shader* existing = findShader(key)) {
+            return existing;
+        }
+
+        std::optional<std::string> source = preprocessShaderSource(path, defines);
+        if (!source) {
+            return nullptr;
+        }
+
+        return registerShader(key, std::move(*source), type, true);
+    }
+
+    Shader* getOrCreateShaderFromSource(const std::string& name, const std::string& source, EShaderType type) {
+        const uint64_t key = calculateShaderKey(name, {});
+        if (Shader* existing = findShader(key)) {
+            return existing;
+        }
+
+        return registerShader(key, source, type, isProgramBinaryCacheEnabled());
+    }
+
+    Shader::Shader(uint32_t shader, EShaderType type, uint64_t sourceHash, std::vector<uint64_t> explicitBlockBindings)
         : m_Id(shader)
-        , m_Type(type) {
+        , m_Type(type)
+        , m_SourceHash(sourceHash)
+        , m_ExplicitBlockBindings(std::move(explicitBlockBindings)) {
+    }
+
+    Shader::Shader(std::string source, EShaderType type, uint64_t sourceHash, std::vector<uint64_t> explicitBlockBindings)
+        : m_DeferredSource(std::move(source))
+        , m_Type(type)
+        , m_SourceHash(sourceHash)
+        , m_ExplicitBlockBindings(std::move(explicitBlockBindings)) {
     }
 
     Shader::~Shader() {
@@ -71,12 +151,38 @@ namespace glass::gfx {
         }
     }
 
+    uint32_t Shader::getId() const {
+        // A failed compilation drops the source too, so the error is reported once
+        if (!m_Id && !m_DeferredSource.empty()) {
+            m_Id = compileShader(m_DeferredSource, m_Type);
+            m_DeferredSource = {};
+        } else if (m_CompilePending) {
+            m_Id = finishShaderCompile(m_Id);
+            m_CompilePending = false;
+        }
+
+        return m_Id;
+    }
+
+    uint32_t Shader::issueCompile() const {
+        if (!m_Id && !m_DeferredSource.empty()) {
+            m_Id = startShaderCompile(m_DeferredSource, m_Type);
+            m_DeferredSource = {};
+            m_CompilePending = true;
+        }
+
+        return m_Id;
+    }
+
     void terminateShaderLibrary() {
         GShaderRegistry.reset();
     }
 
-    ShaderProgram::ShaderProgram(uint32_t id)
+    ShaderProgram::ShaderProgram(uint32_t id, std::span<const uint64_t> explicitBlockBindings)
         : m_Id(id) {
+        // Reflection records the block bindings, so they are assigned first
+        assignUniformBlockBindings(explicitBlockBindings);
+        reflect();
     }
 
     ShaderProgram::~ShaderProgram() {
@@ -86,20 +192,121 @@ namespace glass::gfx {
     }
 
     int32_t ShaderProgram::getUniformLocation(const char* name) const {
-        uint64_t hash = hash::hash64(name, strlen(name));
+        return findUniform(hash::hash64(name, strlen(name)), name).Location;
+    }
+
+    int32_t ShaderProgram::getUniformLocation(hash::CTStringHash name) const {
+        assert(name.str && "Uniform names must be narrow strings");
+        return findUniform(name.value, name.str).Location;
+    }
+
+    UniformLocation ShaderProgram::findUniform(uint64_t hash, const char* name) const {
+        if (m_Reflected) {
+            for (uint64_t slot = hash & m_UniformTableMask; m_UniformTable[slot].Uniform.Location != -1; slot = (slot + 1) & m_UniformTableMask) {
+                if (m_UniformTable[slot].NameHash == hash) {
+                    return m_UniformTable[slot].Uniform;
+                }
+            }
+
+            if (m_MissingUniforms.insert(hash).second) {
+                std::cout << std::format("GLASS warning: Failed to find uniform location with name: {}", name);
+            }
+            return {};
+        }
+
         const auto iter = m_UniformLocations.find(hash);
         if (iter != m_UniformLocations.end()) {
-            return iter->second;
+            return { iter->second, 0 };
         }
 
         int32_t location = glGetUniformLocation(m_Id, name);
         if (location == -1) {
             std::cout << std::format("GLASS warning: Failed to find uniform location with name: {}", name);
-            return location;
+            return {};
         }
 
         m_UniformLocations[hash] = location;
-        return location;
+        return { location, 0 };
+    }
+
+    static bool isBlockBindingTaken(uint32_t binding) {
+        const std::vector<bool>& taken = GShaderRegistry->TakenBlockBindings;
+        return binding < taken.size() && taken[binding];
+    }
+
+    static void takeBlockBinding(uint64_t nameHash, uint32_t binding) {
+        std::vector<bool>& taken = GShaderRegistry->TakenBlockBindings;
+        if (binding >= taken.size()) {
+            taken.resize(binding + 1);
+        }
+
+        taken[binding] = true;
+        GShaderRegistry->BlockBindings[nameHash] = binding;
+    }
+
+    /**
+     * Binding of a block in a new program. An explicit binding from layout(binding = N) is kept,
+     * blocks without one (reported as 0) get the binding of the name or the lowest free binding.
+     */
+    static uint32_t acquireUniformBlockBinding(std::string_view name, uint32_t declared, bool isExplicit) {
+        const uint64_t nameHash = hash::hash64(name.data(), name.size());
+        if (const auto iter = GShaderRegistry->BlockBindings.find(nameHash); iter != GShaderRegistry->BlockBindings.end()) {
+            if (isExplicit && declared != iter->second) {
+                std::cout << std::format("GLASS warning: Uniform block {} declares binding {}, but other programs bind it to {}.", name, declared, iter->second);
+                return declared;
+            }
+            return iter->second;
+        }
+
+        if (isExplicit) {
+            if (isBlockBindingTaken(declared)) {
+                std::cout << std::format("GLASS warning: Uniform block {} declares binding {}, which is already used by another block.", name, declared);
+                return declared;
+            }
+
+            takeBlockBinding(nameHash, declared);
+            return declared;
+        }
+
+        uint32_t binding = 0;
+        while (isBlockBindingTaken(binding)) {
+            ++binding;
+        }
+
+        takeBlockBinding(nameHash, binding);
+        return binding;
+    }
+
+    void ShaderProgram::assignUniformBlockBindings(std::span<const uint64_t> explicitBlockBindings) {
+        GLint blockCount = 0;
+        glGetProgramiv(m_Id, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+        if (blockCount == 0) {
+            return;
+        }
+
+        GLint maxNameLength = 0;
+        glGetProgramiv(m_Id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+        std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+        for (GLint index = 0; index < blockCount; ++index) {
+            GLsizei length = 0;
+            glGetActiveUniformBlockName(m_Id, index, maxNameLength, &length, name.data());
+
+            GLint declared = 0;
+            glGetActiveUniformBlockiv(m_Id, index, GL_UNIFORM_BLOCK_BINDING, &declared);
+
+            const std::string_view blockName(name.data(), length);
+
+            // Elements of block arrays are reported as "Name[i]", the qualifier is declared on "Name"
+            const std::string_view declaredName = blockName.substr(0, blockName.find('['));
+            const bool isExplicit = declared != 0 || std::ranges::find(explicitBlockBindings, hash::hash64(declaredName.data(), declaredName.size())) != explicitBlockBindings.end();
+            const uint32_t binding = acquireUniformBlockBinding(blockName, static_cast<uint32_t>(declared), isExplicit);
+            if (binding != static_cast<uint32_t>(declared)) {
+                glUniformBlockBinding(m_Id, index, binding);
+            }
+
+            m_UniformBlockBindings[hash::hash64(blockName.data(), blockName.size())] = static_cast<int32_t>(binding);
+        }
     }
 
     int32_t ShaderProgram::getUniformBlockBinding(const char* name) const {
@@ -108,16 +315,27 @@ namespace glass::gfx {
             return iter->second;
         }
 
-        const uint32_t index = glGetUniformBlockIndex(m_Id, name);
-        if (index != GL_INVALID_INDEX) {
-            const auto binding = m_NextBlockBinding++;
-            glUniformBlockBinding(m_Id, index, binding);
-            m_UniformBlockBindings[hash] = binding;
-            return binding;
-        } else {
-            std::cout << std::format("GLASS warning: Failed to find uniform block index with name: {}", name);
-            return -1;
+        std::cout << std::format("GLASS warning: Failed to find uniform block index with name: {}", name);
+        return -1;
+    }
+
+    bool reserveUniformBlockBinding(const char* name, uint32_t binding) {
+        const uint64_t nameHash = hash::hash64(name, strlen(name));
+        if (const auto iter = GShaderRegistry->BlockBindings.find(nameHash); iter != GShaderRegistry->BlockBindings.end()) {
+            return iter->second == binding;
+        }
+
+        if (isBlockBindingTaken(binding)) {
+            return false;
         }
+
+        takeBlockBinding(nameHash, binding);
+        return true;
+    }
+
+    uint32_t getUniformBlockBinding(const char* name) {
+        const auto iter = GShaderRegistry->BlockBindings.find(hash::hash64(name, strlen(name)));
+        return iter != GShaderRegistry->BlockBindings.end() ? iter->second : INVALID_BINDING;
     }
 
     static uint64_t calculateShaderProgramHash(const ProgramSpec& spec) {
@@ -131,6 +349,17 @@ namespace glass::gfx {
         return specHash;
     }
 
+    // Sources of all stages identify a program across runs, unlike the shader pointers used by the registry
+    uint64_t calculateProgramBinaryKey(const ProgramSpec& spec) {
+        const Shader* stages[] = { spec.VertexShader, spec.FragmentShader, spec.ComputeShader, spec.GeometryShader, spec.TesellationControlShader, spec.TesellationEvaluationShader };
+
+        uint64_t key = 0x9b1a;
+        for (const Shader* shader : stages) {
+            hash::hashCombine(key, shader ? shader->getSourceHash() : 0);
+        }
+        return key;
+    }
+
     static std::vector<uint32_t> getUniqueShaders(const ProgramSpec& spec) {
         std::vector<uint32_t> out{};
         union {
@@ -148,20 +377,46 @@ namespace glass::gfx {
         return out;
     }
 
-    ShaderProgram* getOrCreateShaderProgram(const ProgramSpec& spec) {
-        const auto hash = calculateShaderProgramHash(spec);
-        if (GShaderRegistry->Programs.contains(hash)) {
-            return GShaderRegistry->Programs.at(hash).get();
+    bool validateProgramSpec(const ProgramSpec& spec) {
+        const std::pair<const Shader*, EShaderType> stages[] = {
+            { spec.VertexShader, EST_VertexShader },
+            { spec.FragmentShader, EST_FragmentShader },
+            { spec.ComputeShader, EST_ComputeShader },
+            { spec.GeometryShader, EST_GeometryShader },
+            { spec.TesellationControlShader, EST_TesellationControlShader },
+            { spec.TesellationEvaluationShader, EST_TesellationEvaluationShader },
+        };
+
+        for (const auto& [shader, type] : stages) {
+            if (shader && shader->getType() != type) {
+                std::cout << std::format("GLASS error: Shader assigned to a wrong stage of the program spec.");
+                return false;
+            }
         }
 
-        uint32_t program = glCreateProgram();
-        auto shaders = getUniqueShaders(spec);
-        for (uint32_t shader : shaders) {
-            glAttachShader(program, shader);
+        if (spec.ComputeShader) {
+            const bool hasGraphicsStages = spec.VertexShader || spec.FragmentShader || spec.GeometryShader || spec.TesellationControlShader || spec.TesellationEvaluationShader;
+            if (hasGraphicsStages) {
+                std::cout << std::format("GLASS error: Compute shaders cannot be linked together with graphics stages.");
+                return false;
+            }
+            return true;
         }
 
-        glLinkProgram(program);
+        if (!spec.VertexShader) {
+            std::cout << std::format("GLASS error: Graphics programs require a vertex shader.");
+            return false;
+        }
+
+        if (spec.TesellationControlShader && !spec.TesellationEvaluationShader) {
+            std::cout << std::format("GLASS error: Tesellation control shader requires a tesellation evaluation shader.");
+            return false;
+        }
 
+        return true;
+    }
+
+    bool checkProgramLinkStatus(uint32_t program, bool validate) {
         int linkStatus;
         glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
         if (!linkStatus) {
@@ -172,11 +427,14 @@ namespace glass::gfx {
             glGetProgramInfoLog(program, len, &len, logInfo.data());
 
             std::cout << std::format("GLASS: Failed to link program: {}", logInfo);
-            return nullptr;
+            return false;
+        }
+
+        int valStatus = GL_TRUE;
+        if (validate) {
+            glGetProgramiv(program, GL_VALIDATE_STATUS, &valStatus);
         }
 
-        int valStatus;
-        glGetProgramiv(program, GL_VALIDATE_STATUS, &valStatus);
         if (!valStatus) {
             int len;
             glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
@@ -185,101 +443,509 @@ namespace glass::gfx {
             glGetProgramInfoLog(program, len, &len, logInfo.data());
 
             std::cout << std::format("GLASS: Failed to validate program: {}", logInfo);
-            return nullptr;
+            return false;
+        }
+
+        return true;
+    }
+
+    static ShaderProgram* findProgram(uint64_t hash) {
+        const auto iter = GShaderRegistry->Programs.find(hash);
+        return iter != GShaderRegistry->Programs.end() ? iter->second.get() : nullptr;
+    }
+
+    static ShaderProgram* registerProgram(uint64_t hash, uint32_t program, const ProgramSpec& spec) {
+        std::vector<uint64_t> explicitBlockBindings{};
+        for (const Shader* shader : { spec.VertexShader, spec.FragmentShader, spec.ComputeShader, spec.GeometryShader, spec.TesellationControlShader, spec.TesellationEvaluationShader }) {
+            if (shader) {
+                const std::span<const uint64_t> blocks = shader->getExplicitBlockBindings();
+                explicitBlockBindings.insert(explicitBlockBindings.end(), blocks.begin(), blocks.end());
+            }
         }
 
-        std::shared_ptr<ShaderProgram> outProgram = std::make_shared<ShaderProgram>(program);
+        std::shared_ptr<ShaderProgram> outProgram = std::make_shared<ShaderProgram>(program, explicitBlockBindings);
         GShaderRegistry->Programs[hash] = outProgram;
         return outProgram.get();
     }
 
+    ShaderProgram* findShaderProgram(const ProgramSpec& spec) {
+        return findProgram(calculateShaderProgramHash(spec));
+    }
+
+    ShaderProgram* registerShaderProgram(const ProgramSpec& spec, uint32_t program) {
+        return registerProgram(calculateShaderProgramHash(spec), program, spec);
+    }
+
+    static ShaderProgram* linkProgram(uint64_t hash, const ProgramSpec& spec, uint64_t binaryKey, bool separable) {
+        uint32_t program = glCreateProgram();
+        if (separable) {
+            glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+        }
+
+        const bool useBinaryCache = isProgramBinaryCacheEnabled();
+        if (useBinaryCache && loadProgramBinary(program, binaryKey)) {
+            return registerProgram(hash, program, spec);
+        }
+
+        // Compiles deferred shaders, which print their compile errors here
+        auto shaders = getUniqueShaders(spec);
+        for (uint32_t shader : shaders) {
+            if (!shader) {
+                std::cout << std::format("GLASS error: Program not linked, a shader failed to compile");
+                glDeleteProgram(program);
+                return nullptr;
+            }
+            glAttachShader(program, shader);
+        }
+
+        if (useBinaryCache) {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        glLinkProgram(program);
+
+        // Validation checks the program against the graphics pipeline state, which does not apply to compute programs
+        // or to single stages of a pipeline.
+        if (!checkProgramLinkStatus(program, !spec.ComputeShader && !separable)) {
+            glDeleteProgram(program);
+            return nullptr;
+        }
+
+        if (useBinaryCache) {
+            storeProgramBinary(program, binaryKey);
+        }
+
+        return registerProgram(hash, program, spec);
+    }
+
+    ShaderProgram* getOrCreateShaderProgram(const ProgramSpec& spec) {
+        const uint64_t hash = calculateShaderProgramHash(spec);
+        if (ShaderProgram* existing = findProgram(hash)) {
+            return existing;
+        }
+
+        if (!validateProgramSpec(spec)) {
+            return nullptr;
+        }
+
+        return linkProgram(hash, spec, isProgramBinaryCacheEnabled() ? calculateProgramBinaryKey(spec) : 0, false);
+    }
+
+    ShaderProgram* getOrCreateSeparableProgram(Shader* shader) {
+        assert(shader);
+
+        // Seeded differently from calculateShaderProgramHash, so a separable compute program doesn't collide with the regular one
+        uint64_t hash = 0x5e9a;
+        hash::hashCombine(hash, shader);
+        if (ShaderProgram* existing = findProgram(hash)) {
+            return existing;
+        }
+
+        ProgramSpec spec{};
+        Shader** stages[] = { &spec.VertexShader, &spec.FragmentShader, &spec.ComputeShader, &spec.GeometryShader, &spec.TesellationControlShader, &spec.TesellationEvaluationShader };
+        *stages[shader->getType()] = shader;
+
+        uint64_t binaryKey = 0;
+        if (isProgramBinaryCacheEnabled()) {
+            binaryKey = calculateProgramBinaryKey(spec);
+            hash::hashCombine(binaryKey, 0x5e9a);
+        }
+
+        return linkProgram(hash, spec, binaryKey, true);
+    }
+
     void bindShaderProgram(const ShaderProgram* program) {
         glUseProgram(program->getId());
     }
 
+    static void uploadUniform(const ShaderProgram* program, int32_t location, float uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform1f(program->getId(), location, uniform);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::vec2 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform2f(program->getId(), location, uniform.x, uniform.y);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::vec3 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform3f(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::vec4 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform4f(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, int32_t uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform1i(program->getId(), location, uniform);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::ivec2 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform2i(program->getId(), location, uniform.x, uniform.y);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::ivec3 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform3i(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::ivec4 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform4i(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, uint32_t uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform1ui(program->getId(), location, uniform);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::uvec2 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform2ui(program->getId(), location, uniform.x, uniform.y);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::uvec3 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform3ui(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, glm::uvec4 uniform) {
+        if (program->shadowUniform(location, &uniform, sizeof(uniform))) {
+            glProgramUniform4ui(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        }
+    }
+
+    // Matrices are shadowed the way GL stores them, so transposed and plain writes of the same matrix compare equal
+    static void uploadUniform(const ShaderProgram* program, int32_t location, const glm::mat3& uniform, bool transpose) {
+        const glm::mat3 matrix = transpose ? glm::transpose(uniform) : uniform;
+        if (program->shadowUniform(location, &matrix, sizeof(matrix))) {
+            glProgramUniformMatrix3fv(program->getId(), location, 1, GL_FALSE, glm::value_ptr(matrix));
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, const glm::mat4& uniform, bool transpose) {
+        const glm::mat4 matrix = transpose ? glm::transpose(uniform) : uniform;
+        if (program->shadowUniform(location, &matrix, sizeof(matrix))) {
+            glProgramUniformMatrix4fv(program->getId(), location, 1, GL_FALSE, glm::value_ptr(matrix));
+        }
+    }
+
+    static void uploadUniform(const ShaderProgram* program, int32_t location, std::span<const glm::vec4> uniforms) {
+        if (program->shadowUniform(location, uniforms.data(), sizeof(glm::vec4), static_cast<uint32_t>(uniforms.size()))) {
+            glProgramUniform4fv(program->getId(), location, static_cast<GLsizei>(uniforms.size()), glm::value_ptr(uniforms[0]));
+        }
+    }
+
     void setUniform(const ShaderProgram* program, const char* name, float uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform1f(program->getId(), location, uniform);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::vec2 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform2f(program->getId(), location, uniform.x, uniform.y);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::vec3 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform3f(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::vec4 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform4f(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, int32_t uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform1i(program->getId(), location, uniform);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::ivec2 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform2i(program->getId(), location, uniform.x, uniform.y);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::ivec3 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform3i(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::ivec4 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform4i(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, uint32_t uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform1ui(program->getId(), location, uniform);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::uvec2 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform2ui(program->getId(), location, uniform.x, uniform.y);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::uvec3 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform3ui(program->getId(), location, uniform.x, uniform.y, uniform.z);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, glm::uvec4 uniform) {
-        int32_t location = program->getUniformLocation(name);
-        glProgramUniform4ui(program->getId(), location, uniform.x, uniform.y, uniform.z, uniform.w);
+        uploadUniform(program, program->getUniformLocation(name), uniform);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, const glm::mat3& uniform, bool transpose) {
-        glProgramUniformMatrix3fv(program->getId(), program->getUniformLocation(name), 1, transpose, glm::value_ptr(uniform));
+        uploadUniform(program, program->getUniformLocation(name), uniform, transpose);
     }
 
     void setUniform(const ShaderProgram* program, const char* name, const glm::mat4& uniform, bool transpose) {
-        glProgramUniformMatrix4fv(program->getId(), program->getUniformLocation(name), 1, transpose, glm::value_ptr(uniform));
+        uploadUniform(program, program->getUniformLocation(name), uniform, transpose);
+    }
+
+    void setUniform(const ShaderProgram* program, const char* name, std::span<const glm::vec4> uniforms) {
+        uploadUniform(program, program->getUniformLocation(name), uniforms);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, float uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec2 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec3 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::vec4 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, int32_t uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec2 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec3 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::ivec4 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, uint32_t uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec2 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec3 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, glm::uvec4 uniform) {
+        uploadUniform(program, program->getUniformLocation(name), uniform);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, const glm::mat3& uniform, bool transpose) {
+        uploadUniform(program, program->getUniformLocation(name), uniform, transpose);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, const glm::mat4& uniform, bool transpose) {
+        uploadUniform(program, program->getUniformLocation(name), uniform, transpose);
+    }
+
+    void setUniform(const ShaderProgram* program, hash::CTStringHash name, std::span<const glm::vec4> uniforms) {
+        uploadUniform(program, program->getUniformLocation(name), uniforms);
+    }
+
+    // Handles pack the location into the low and the GL type of the uniform into the high 32 bits
+    static UniformHandle makeUniformHandle(int32_t location, GLenum type) {
+        return static_cast<UniformHandle>(static_cast<uint64_t>(type) << 32 | static_cast<uint32_t>(location));
+    }
+
+    static int32_t getUniformHandleLocation(UniformHandle uniform) {
+        return static_cast<int32_t>(static_cast<uint64_t>(uniform) & UINT32_MAX);
+    }
+
+    [[maybe_unused]] static GLenum getUniformHandleType(UniformHandle uniform) {
+        return static_cast<GLenum>(static_cast<uint64_t>(uniform) >> 32);
+    }
+
+    static UniformHandle resolveUniform(const ShaderProgram* program, uint64_t hash, const char* name) {
+        UniformLocation uniform = program->findUniform(hash, name);
+        if (uniform.Location == -1) {
+            return UniformHandle::Invalid;
+        }
+
+        // Without reflection the type is queried here
+        if (uniform.Type == 0) {
+            GLuint index = GL_INVALID_INDEX;
+            glGetUniformIndices(program->getId(), 1, &name, &index);
+
+            GLint type = 0;
+            if (index != GL_INVALID_INDEX) {
+                glGetActiveUniformsiv(program->getId(), 1, &index, GL_UNIFORM_TYPE, &type);
+            }
+            uniform.Type = static_cast<uint32_t>(type);
+        }
+
+        return makeUniformHandle(uniform.Location, uniform.Type);
+    }
+
+    UniformHandle resolveUniform(const ShaderProgram* program, const char* name) {
+        return resolveUniform(program, hash::hash64(name, strlen(name)), name);
+    }
+
+    UniformHandle resolveUniform(const ShaderProgram* program, hash::CTStringHash name) {
+        assert(name.str && "Uniform names must be narrow strings");
+        return resolveUniform(program, name.value, name.str);
+    }
+
+    // Booleans can be set with any scalar type of the same component count, samplers and images are set with an int
+    [[maybe_unused]] static bool isUniformTypeCompatible(GLenum uniformType, GLenum valueType) {
+        if (uniformType == 0 || uniformType == valueType) {
+            return true;
+        }
+
+        static constexpr GLenum NUMERIC_TYPES[][4] = {
+            { GL_BOOL, GL_FLOAT, GL_INT, GL_UNSIGNED_INT },
+            { GL_BOOL_VEC2, GL_FLOAT_VEC2, GL_INT_VEC2, GL_UNSIGNED_INT_VEC2 },
+            { GL_BOOL_VEC3, GL_FLOAT_VEC3, GL_INT_VEC3, GL_UNSIGNED_INT_VEC3 },
+            { GL_BOOL_VEC4, GL_FLOAT_VEC4, GL_INT_VEC4, GL_UNSIGNED_INT_VEC4 },
+        };
+
+        for (const auto& types : NUMERIC_TYPES) {
+            if (uniformType == types[0]) {
+                return std::ranges::find(types, valueType) != std::end(types);
+            }
+            if (std::ranges::find(types, uniformType) != std::end(types)) {
+                return false;
+            }
+        }
+
+        return valueType == GL_INT && uniformType != GL_FLOAT_MAT3 && uniformType != GL_FLOAT_MAT4;
+    }
+
+    template <typename Value>
+    static constexpr GLenum GUniformValueType = 0;
+    template <> constexpr GLenum GUniformValueType<float> = GL_FLOAT;
+    template <> constexpr GLenum GUniformValueType<glm::vec2> = GL_FLOAT_VEC2;
+    template <> constexpr GLenum GUniformValueType<glm::vec3> = GL_FLOAT_VEC3;
+    template <> constexpr GLenum GUniformValueType<glm::vec4> = GL_FLOAT_VEC4;
+    template <> constexpr GLenum GUniformValueType<int32_t> = GL_INT;
+    template <> constexpr GLenum GUniformValueType<glm::ivec2> = GL_INT_VEC2;
+    template <> constexpr GLenum GUniformValueType<glm::ivec3> = GL_INT_VEC3;
+    template <> constexpr GLenum GUniformValueType<glm::ivec4> = GL_INT_VEC4;
+    template <> constexpr GLenum GUniformValueType<uint32_t> = GL_UNSIGNED_INT;
+    template <> constexpr GLenum GUniformValueType<glm::uvec2> = GL_UNSIGNED_INT_VEC2;
+    template <> constexpr GLenum GUniformValueType<glm::uvec3> = GL_UNSIGNED_INT_VEC3;
+    template <> constexpr GLenum GUniformValueType<glm::uvec4> = GL_UNSIGNED_INT_VEC4;
+    template <> constexpr GLenum GUniformValueType<glm::mat3> = GL_FLOAT_MAT3;
+    template <> constexpr GLenum GUniformValueType<glm::mat4> = GL_FLOAT_MAT4;
+
+    template <typename Value, typename... Args>
+    static void uploadUniformByHandle(const ShaderProgram* program, UniformHandle uniform, const Value& value, Args... args) {
+        assert(isUniformTypeCompatible(getUniformHandleType(uniform), GUniformValueType<Value>) && "Value type doesn't match the uniform type");
+        uploadUniform(program, getUniformHandleLocation(uniform), value, args...);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, float value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec2 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec3 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::vec4 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, int32_t value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec2 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec3 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::ivec4 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, uint32_t value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec2 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec3 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, glm::uvec4 value) {
+        uploadUniformByHandle(program, uniform, value);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, const glm::mat3& value, bool transpose) {
+        uploadUniformByHandle(program, uniform, value, transpose);
+    }
+
+    void setUniform(const ShaderProgram* program, UniformHandle uniform, const glm::mat4& value, bool transpose) {
+        uploadUniformByHandle(program, uniform, value, transpose);
     }
 
     void setUniformTexture(const ShaderProgram* program, const char* name, ResourceID id, uint32_t slot) {
-        const GLenum textureType = toGLTextureType(getTextureType(id));
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(textureType, getTextureID(id));
+        setUniformTexture(program, name, id, ResourceID::Null, slot);
+    }
+
+    void setUniformTexture(const ShaderProgram* program, const char* name, ResourceID id, ResourceID sampler, uint32_t slot) {
+        bindTextureUnit(slot, id);
+        bindSampler(slot, sampler);
         setUniform(program, name, static_cast<int32_t>(slot));
     }
 
+    void setUniformTexture(const ShaderProgram* program, UniformHandle uniform, ResourceID id, uint32_t slot) {
+        setUniformTexture(program, uniform, id, ResourceID::Null, slot);
+    }
+
+    void setUniformTexture(const ShaderProgram* program, UniformHandle uniform, ResourceID id, ResourceID sampler, uint32_t slot) {
+        bindTextureUnit(slot, id);
+        bindSampler(slot, sampler);
+        setUniform(program, uniform, static_cast<int32_t>(slot));
+    }
+
     void setUniformBuffer(const ShaderProgram* program, const char* name, ResourceID id, uint32_t optBinding) {
         if (optBinding != INVALID_BINDING) {
-            glBindBufferBase(GL_UNIFORM_BUFFER, optBinding, getBufferID(id));
+            bindUniformBufferBase(optBinding, id);
         } else {
             assert(name != nullptr);
             const auto binding = program->getUniformBlockBinding(name);
             if (binding != -1) {
-                glBindBufferBase(GL_UNIFORM_BUFFER, binding, getBufferID(id));
+                bindUniformBufferBase(static_cast<uint32_t>(binding), id);
             }
         }
     }
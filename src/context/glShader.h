@@ -1,35 +1,145 @@
 #pragma once
 
 #include "glass/glass.h"
+#include "unordered_map"
+#include "unordered_set"
 
 namespace glass::gfx {
     class Shader {
     public:
-        Shader(uint32_t shader, EShaderType type);
+        /** @param explicitBlockBindings Name hashes of the uniform blocks declared with layout(binding = N) */
+        Shader(uint32_t shader, EShaderType type, uint64_t sourceHash, std::vector<uint64_t> explicitBlockBindings = {});
+
+        /** Compilation is deferred until a program that can't be loaded from the binary cache links the shader */
+        Shader(std::string source, EShaderType type, uint64_t sourceHash, std::vector<uint64_t> explicitBlockBindings = {});
         ~Shader();
 
-        inline uint32_t getId() const { return m_Id; }
+        /** Compiles a deferred shader or waits for the compilation started by issueCompile. 0 if the compilation failed. */
+        uint32_t getId() const;
+
+        /**
+         * Start compiling a deferred shader without waiting for the result, so the driver can compile it in parallel.
+         * @return Name of the shader, which can be attached before the compilation finishes. 0 if an earlier compilation failed.
+         */
+        uint32_t issueCompile() const;
+        inline EShaderType getType() const { return m_Type; }
+        inline uint64_t getSourceHash() const { return m_SourceHash; }
+        inline std::span<const uint64_t> getExplicitBlockBindings() const { return m_ExplicitBlockBindings; }
 
     private:
-        uint32_t m_Id{};
+        mutable uint32_t m_Id{};
+        mutable std::string m_DeferredSource{};
+        mutable bool m_CompilePending{};
         EShaderType m_Type{};
+        uint64_t m_SourceHash{};
+        std::vector<uint64_t> m_ExplicitBlockBindings{};
+    };
+
+    /** Default block uniform, array elements included */
+    struct UniformLocation {
+        int32_t Location{ -1 };
+
+        /** GL type, 0 if unknown */
+        uint32_t Type{};
     };
 
     class ShaderProgram {
     public:
-        ShaderProgram(uint32_t id);
+        /**
+         * @param explicitBlockBindings Name hashes of the uniform blocks declared with layout(binding = N) in the linked shaders.
+         * Blocks missing there that GL reports at binding 0 count as having no binding and are moved to a process wide one.
+         * The qualifier is found in the source text, so a binding 0 hidden in a macro like layout(MY_LAYOUT) is not recognized.
+         */
+        ShaderProgram(uint32_t id, std::span<const uint64_t> explicitBlockBindings = {});
         ~ShaderProgram();
 
         inline uint32_t getId() const { return m_Id; }
         int32_t getUniformLocation(const char* name) const;
+        int32_t getUniformLocation(hash::CTStringHash name) const;
+        UniformLocation findUniform(uint64_t hash, const char* name) const;
         int32_t getUniformBlockBinding(const char* name) const;
 
+        /**
+         * Compare a value with the last one written to the location and remember it.
+         * @param count Number of array elements of the given size at consecutive locations. Counted as one upload.
+         * @return true if the value changed and has to be uploaded, false for unchanged values and locations of -1
+         */
+        bool shadowUniform(int32_t location, const void* data, uint32_t size, uint32_t count = 1) const;
+        inline const UniformUploadStats& getUploadStats() const { return m_UploadStats; }
+        inline void resetUploadStats() const { m_UploadStats = {}; }
+
+        inline bool isReflected() const { return m_Reflected; }
+        inline std::span<const ShaderResourceInfo> getResources() const { return m_Resources; }
+        const ShaderResourceInfo* findResource(EShaderResourceType type, std::string_view name) const;
+
     private:
+        /** Fill the resource and uniform tables from the program interfaces. Needs GL 4.3. */
+        void reflect();
+        void insertUniform(uint64_t hash, UniformLocation uniform);
+        void allocateUniformShadows();
+
+        /** Bind every uniform block without an explicit binding to its process wide binding */
+        void assignUniformBlockBindings(std::span<const uint64_t> explicitBlockBindings);
+
+    private:
+        struct UniformEntry {
+            uint64_t NameHash{};
+            UniformLocation Uniform{};
+        };
+
         uint32_t m_Id{};
+        bool m_Reflected{};
+
+        /** Sorted by type and name */
+        std::vector<ShaderResourceInfo> m_Resources{};
+
+        /** Open addressing table of default block uniforms with every array element. Empty slots have location -1. */
+        std::vector<UniformEntry> m_UniformTable{};
+        uint64_t m_UniformTableMask{};
+
+        /** @return true if the value at the location differs from its shadow or the location has none */
+        bool updateUniformShadow(int32_t location, const void* data, uint32_t size) const;
+
+        struct UniformShadow {
+            uint32_t Offset{};
+            uint32_t Size{};
+            bool Written{};
+        };
+
+        /** Last written values of reflected uniforms, indexed by location. Size 0 means the location isn't shadowed. */
+        mutable std::vector<UniformShadow> m_UniformShadows{};
+        mutable std::vector<uint8_t> m_UniformShadowData{};
+        mutable UniformUploadStats m_UploadStats{};
+
+        /** Names reported missing, so a missing uniform warns only once */
+        mutable std::unordered_set<uint64_t> m_MissingUniforms{};
+
+        /** Lazily filled when the program couldn't be reflected */
         mutable std::unordered_map<uint64_t, int32_t> m_UniformLocations{};
-        mutable std::unordered_map<uint64_t, int32_t> m_UniformBlockBindings{};
-        mutable uint32_t m_NextBlockBinding{0};
+
+        /** Bindings of the uniform blocks of the program, by name hash */
+        std::unordered_map<uint64_t, int32_t> m_UniformBlockBindings{};
     };
 
+    /**
+     * Get or create shader from the source code in memory (used for shaders built into glass).
+     * The name is used as the registry key instead of a file path.
+     */
+    Shader* getOrCreateShaderFromSource(const std::string& name, const std::string& source, EShaderType type);
+
+    /** Get or create shader from a file, always deferring the compilation */
+    Shader* getOrCreateDeferredShader(const std::string& path, EShaderType type, std::span<const ShaderDefine> defines);
+
+    bool validateProgramSpec(const ProgramSpec& spec);
+    uint64_t calculateProgramBinaryKey(const ProgramSpec& spec);
+
+    /** Query link (and optionally validate) status of a program and print its log on failure */
+    bool checkProgramLinkStatus(uint32_t program, bool validate);
+
+    ShaderProgram* findShaderProgram(const ProgramSpec& spec);
+
+    /** Take ownership of a linked program and add it to the registry */
+    ShaderProgram* registerShaderProgram(const ProgramSpec& spec, uint32_t program);
+
     void terminateShaderLibrary();
 } // namespace glass::gfx
\ No newline at end of file
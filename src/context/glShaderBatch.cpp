@@ -0,0 +1,244 @@
+#include "glShaderBatch.h"
+#include "glShader.h"
+#include "glInternal.h"
+#include "glProgramCache.h"
+
+#include "GLFW/glfw3.h"
+#include "algorithm"
+#include "array"
+#include "memory"
+
+namespace glass::gfx {
+    struct ParallelCompileSupport {
+        bool Checked{};
+        bool Supported{};
+    };
+
+    static ParallelCompileSupport GParallelCompile{};
+    static std::vector<std::unique_ptr<ShaderCompileBatch>> GShaderCompileBatches{};
+
+    using MaxShaderCompilerThreadsFn = void (APIENTRYP)(GLuint count);
+
+    static void initParallelShaderCompile() {
+        if (GParallelCompile.Checked) {
+            return;
+        }
+
+        GParallelCompile.Checked = true;
+
+        const char* functionName = nullptr;
+        if (glfwExtensionSupported("GL_KHR_parallel_shader_compile")) {
+            functionName = "glMaxShaderCompilerThreadsKHR";
+        } else if (glfwExtensionSupported("GL_ARB_parallel_shader_compile")) {
+            functionName = "glMaxShaderCompilerThreadsARB";
+        } else {
+            return;
+        }
+
+        GParallelCompile.Supported = true;
+
+        // The maximum count lets the driver pick the number of compiler threads
+        if (auto maxThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(glfwGetProcAddress(functionName))) {
+            maxThreads(0xFFFFFFFF);
+        }
+    }
+
+    static std::array<const Shader*, 6> getStages(const ProgramSpec& spec) {
+        return { spec.VertexShader, spec.FragmentShader, spec.ComputeShader, spec.GeometryShader, spec.TesellationControlShader, spec.TesellationEvaluationShader };
+    }
+
+    ShaderCompileBatch::~ShaderCompileBatch() {
+        poll(true);
+    }
+
+    std::shared_future<ShaderProgram*> ShaderCompileBatch::add(const ProgramSourceSpec& source) {
+        bool sourcesFound = true;
+        auto getStage = [&source, &sourcesFound](const std::string& path, EShaderType type) -> Shader* {
+            if (path.empty()) {
+                return nullptr;
+            }
+
+            Shader* shader = getOrCreateDeferredShader(path, type, source.Defines);
+            sourcesFound &= shader != nullptr;
+            return shader;
+        };
+
+        Entry entry{};
+        entry.Spec.VertexShader = getStage(source.VertexShader, EST_VertexShader);
+        entry.Spec.FragmentShader = getStage(source.FragmentShader, EST_FragmentShader);
+        entry.Spec.ComputeShader = getStage(source.ComputeShader, EST_ComputeShader);
+        entry.Spec.GeometryShader = getStage(source.GeometryShader, EST_GeometryShader);
+        entry.Spec.TesellationControlShader = getStage(source.TesellationControlShader, EST_TesellationControlShader);
+        entry.Spec.TesellationEvaluationShader = getStage(source.TesellationEvaluationShader, EST_TesellationEvaluationShader);
+
+        std::shared_future<ShaderProgram*> future = entry.Promise.get_future().share();
+        if (ShaderProgram* existing = findShaderProgram(entry.Spec)) {
+            entry.Promise.set_value(existing);
+            return future;
+        }
+
+        if (!sourcesFound || !validateProgramSpec(entry.Spec)) {
+            entry.Promise.set_value(nullptr);
+            return future;
+        }
+
+        m_Queued.push_back(std::move(entry));
+        return future;
+    }
+
+    void ShaderCompileBatch::submit() {
+        const bool useBinaryCache = isProgramBinaryCacheEnabled();
+        const size_t firstSubmitted = m_Pending.size();
+        for (Entry& entry : m_Queued) {
+            if (ShaderProgram* existing = findShaderProgram(entry.Spec)) {
+                entry.Promise.set_value(existing);
+                continue;
+            }
+
+            entry.Program = glCreateProgram();
+            if (useBinaryCache) {
+                entry.BinaryKey = calculateProgramBinaryKey(entry.Spec);
+                entry.StoreBinary = true;
+                if (loadProgramBinary(entry.Program, entry.BinaryKey)) {
+                    entry.Promise.set_value(registerShaderProgram(entry.Spec, entry.Program));
+                    continue;
+                }
+            }
+
+            m_Pending.push_back(std::move(entry));
+        }
+
+        m_Queued.clear();
+
+        // Issue every compilation before the first link, since drivers without parallel compilation link synchronously
+        for (size_t i = firstSubmitted; i < m_Pending.size(); ++i) {
+            for (const Shader* shader : getStages(m_Pending[i].Spec)) {
+                if (shader) {
+                    shader->issueCompile();
+                }
+            }
+        }
+
+        for (size_t i = firstSubmitted; i < m_Pending.size(); ++i) {
+            Entry& entry = m_Pending[i];
+            for (const Shader* shader : getStages(entry.Spec)) {
+                if (!shader) {
+                    continue;
+                }
+
+                // A shader that failed in an earlier batch has no name left to attach
+                const uint32_t id = shader->issueCompile();
+                if (!id) {
+                    glDeleteProgram(entry.Program);
+                    entry.Program = 0;
+                    break;
+                }
+
+                glAttachShader(entry.Program, id);
+            }
+
+            if (!entry.Program) {
+                continue;
+            }
+
+            if (entry.StoreBinary) {
+                glProgramParameteri(entry.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            }
+
+            glLinkProgram(entry.Program);
+        }
+    }
+
+    bool ShaderCompileBatch::poll(bool wait) {
+        if (!m_Queued.empty()) {
+            submit();
+        }
+
+        std::erase_if(m_Pending, [this, wait](Entry& entry) {
+            if (entry.Program && !wait && GParallelCompile.Supported) {
+                int completed = GL_FALSE;
+                glGetProgramiv(entry.Program, GL_COMPLETION_STATUS_KHR, &completed);
+                if (!completed) {
+                    return false;
+                }
+            }
+
+            resolve(entry);
+            return true;
+        });
+
+        return m_Pending.empty();
+    }
+
+    void ShaderCompileBatch::resolve(Entry& entry) {
+        if (!entry.Program) {
+            entry.Promise.set_value(nullptr);
+            return;
+        }
+
+        // Every stage is checked, so the log of each failing shader is printed
+        bool compiled = true;
+        for (const Shader* shader : getStages(entry.Spec)) {
+            if (shader && !shader->getId()) {
+                compiled = false;
+            }
+        }
+
+        if (!compiled || !checkProgramLinkStatus(entry.Program, !entry.Spec.ComputeShader)) {
+            glDeleteProgram(entry.Program);
+            entry.Promise.set_value(nullptr);
+            return;
+        }
+
+        // The same program may have been added twice or created outside the batch meanwhile
+        if (ShaderProgram* existing = findShaderProgram(entry.Spec)) {
+            glDeleteProgram(entry.Program);
+            entry.Promise.set_value(existing);
+            return;
+        }
+
+        if (entry.StoreBinary) {
+            storeProgramBinary(entry.Program, entry.BinaryKey);
+        }
+
+        entry.Promise.set_value(registerShaderProgram(entry.Spec, entry.Program));
+    }
+
+    void freeShaderCompileBatches() {
+        GShaderCompileBatches.clear();
+        GParallelCompile = {};
+    }
+
+    ShaderCompileBatch* createShaderCompileBatch() {
+        initParallelShaderCompile();
+        return GShaderCompileBatches.emplace_back(std::make_unique<ShaderCompileBatch>()).get();
+    }
+
+    void destroyShaderCompileBatch(ShaderCompileBatch* batch) {
+        auto iter = std::ranges::find_if(GShaderCompileBatches, [batch](const std::unique_ptr<ShaderCompileBatch>& b) { return b.get() == batch; });
+        if (iter != GShaderCompileBatches.end()) {
+            GShaderCompileBatches.erase(iter);
+        }
+    }
+
+    std::shared_future<ShaderProgram*> addShaderProgram(ShaderCompileBatch* batch, const ProgramSourceSpec& spec) {
+        return batch->add(spec);
+    }
+
+    void submitShaderCompileBatch(ShaderCompileBatch* batch) {
+        batch->submit();
+    }
+
+    bool pollShaderCompileBatch(ShaderCompileBatch* batch) {
+        return batch->poll(false);
+    }
+
+    void finishShaderCompileBatch(ShaderCompileBatch* batch) {
+        batch->poll(true);
+    }
+
+    bool isParallelShaderCompileSupported() {
+        initParallelShaderCompile();
+        return GParallelCompile.Supported;
+    }
+} // namespace glass::gfx
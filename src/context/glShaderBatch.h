@@ -0,0 +1,44 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "future"
+
+namespace glass::gfx {
+    class ShaderCompileBatch {
+    public:
+        ShaderCompileBatch() = default;
+        ~ShaderCompileBatch();
+
+        ShaderCompileBatch(const ShaderCompileBatch&) = delete;
+        ShaderCompileBatch& operator=(const ShaderCompileBatch&) = delete;
+
+        std::shared_future<ShaderProgram*> add(const ProgramSourceSpec& spec);
+        void submit();
+
+        /** @param wait block until all submitted programs are done */
+        bool poll(bool wait);
+
+    private:
+        struct Entry {
+            ProgramSpec Spec{};
+            uint32_t Program{};
+            uint64_t BinaryKey{};
+
+            /** Linked with the retrievable hint to be stored in the binary cache */
+            bool StoreBinary{};
+            std::promise<ShaderProgram*> Promise{};
+        };
+
+        /** Query statuses of a program whose linking finished and fulfill its promise */
+        void resolve(Entry& entry);
+
+    private:
+        /** Added but not submitted yet */
+        std::vector<Entry> m_Queued{};
+
+        /** Linking, not resolved yet */
+        std::vector<Entry> m_Pending{};
+    };
+
+    void freeShaderCompileBatches();
+} // namespace glass::gfx
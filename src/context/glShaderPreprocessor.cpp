@@ -0,0 +1,288 @@
+#include "glShaderPreprocessor.h"
+#include "io/mappedFile.h"
+
+#include "iostream"
+#include "filesystem"
+#include "algorithm"
+#include "memory"
+#include "unordered_map"
+
+namespace glass::gfx {
+    /** Text of a file up to an #include directive. The include is empty for the last segment of the file. */
+    struct ShaderSourceSegment {
+        std::string_view Text{};
+
+        /** Normalized path of the included file */
+        std::string Include{};
+
+        /** Number of the line after the directive, restored with #line after the included text */
+        uint32_t NextLine{};
+    };
+
+    struct ShaderSourceFile {
+        /** Copied out of the mapping, so the file can be edited or deleted while the application runs */
+        std::string Text{};
+        std::vector<ShaderSourceSegment> Segments{};
+
+        /** Source string number used by #line directives */
+        uint32_t Index{};
+
+        /** Offset and number of the line following the #version directive, 0 if the file has none */
+        size_t VersionEnd{};
+        uint32_t VersionNextLine{};
+    };
+
+    static std::unordered_map<std::string, std::unique_ptr<ShaderSourceFile>> GShaderSourceCache{};
+
+    static std::string_view skipBlanks(std::string_view text) {
+        const size_t start = text.find_first_not_of(" \t");
+        return start == std::string_view::npos ? std::string_view{} : text.substr(start);
+    }
+
+    /** @return Name of the preprocessor directive on the line and the rest of the line */
+    static std::pair<std::string_view, std::string_view> parseDirective(std::string_view line) {
+        line = skipBlanks(line);
+        if (line.empty() || line.front() != '#') {
+            return {};
+        }
+
+        line = skipBlanks(line.substr(1));
+        const size_t nameEnd = std::min(line.find_first_of(" \t\r\"<"), line.size());
+        return { line.substr(0, nameEnd), skipBlanks(line.substr(nameEnd)) };
+    }
+
+    static std::optional<std::string_view> parseIncludePath(std::string_view arguments) {
+        if (arguments.empty() || (arguments.front() != '"' && arguments.front() != '<')) {
+            return std::nullopt;
+        }
+
+        const char closing = arguments.front() == '"' ? '"' : '>';
+        const size_t end = arguments.find(closing, 1);
+        if (end == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        return arguments.substr(1, end - 1);
+    }
+
+    static const ShaderSourceFile* loadShaderSourceFile(const std::string& path) {
+        if (const auto iter = GShaderSourceCache.find(path); iter != GShaderSourceCache.end()) {
+            return iter->second.get();
+        }
+
+        auto source = std::make_unique<ShaderSourceFile>();
+        {
+            const io::MappedFile file(path);
+            if (!file.isOpen()) {
+                std::cout << std::format("GLASS error: Failed to open shader source: {}", path);
+                return nullptr;
+            }
+
+            source->Text.assign(reinterpret_cast<const char*>(file.getData()), file.getSize());
+        }
+
+        source->Index = static_cast<uint32_t>(GShaderSourceCache.size());
+
+        const std::string_view text = source->Text;
+        const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+        size_t segmentStart = 0;
+        size_t lineStart = 0;
+        uint32_t line = 1;
+        while (lineStart < text.size()) {
+            const size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+            const size_t nextLineStart = std::min(lineEnd + 1, text.size());
+            const auto [directive, arguments] = parseDirective(text.substr(lineStart, lineEnd - lineStart));
+
+            if (directive == "version" && !source->VersionNextLine) {
+                source->VersionEnd = nextLineStart;
+                source->VersionNextLine = line + 1;
+            } else if (directive == "include") {
+                if (const auto includePath = parseIncludePath(arguments)) {
+                    ShaderSourceSegment& segment = source->Segments.emplace_back();
+                    segment.Text = text.substr(segmentStart, lineStart - segmentStart);
+                    segment.Include = (directory / *includePath).lexically_normal().generic_string();
+                    segment.NextLine = line + 1;
+                    segmentStart = nextLineStart;
+                } else {
+                    std::cout << std::format("GLASS warning: Malformed #include directive in {} on line {}", path, line);
+                }
+            }
+
+            lineStart = nextLineStart;
+            ++line;
+        }
+
+        source->Segments.push_back({ text.substr(segmentStart) });
+        return GShaderSourceCache.emplace(path, std::move(source)).first->second.get();
+    }
+
+    static bool appendShaderSource(const ShaderSourceFile& source, std::string& out, std::vector<const ShaderSourceFile*>& included) {
+        for (const ShaderSourceSegment& segment : source.Segments) {
+            out.append(segment.Text);
+            if (segment.Include.empty()) {
+                continue;
+            }
+
+            const ShaderSourceFile* include = loadShaderSourceFile(segment.Include);
+            if (!include) {
+                return false;
+            }
+
+            // Including every file only once also breaks include cycles
+            if (std::ranges::find(included, include) == included.end()) {
+                included.push_back(include);
+                out.append(std::format("#line 1 {}\n", include->Index));
+                if (!appendShaderSource(*include, out, included)) {
+                    return false;
+                }
+
+                if (!out.empty() && out.back() != '\n') {
+                    out.push_back('\n');
+                }
+            }
+
+            out.append(std::format("#line {} {}\n", segment.NextLine, source.Index));
+        }
+
+        return true;
+    }
+
+    uint64_t calculateShaderDefinesHash(std::span<const ShaderDefine> defines) {
+        std::vector<const ShaderDefine*> sorted{};
+        sorted.reserve(defines.size());
+        for (const ShaderDefine& define : defines) {
+            sorted.push_back(&define);
+        }
+
+        std::ranges::sort(sorted, {}, [](const ShaderDefine* define) { return std::string_view{ define->Name }; });
+
+        uint64_t definesHash = 0xdef5;
+        for (const ShaderDefine* define : sorted) {
+            hash::hashCombine(definesHash, define->Name);
+            hash::hashCombine(definesHash, define->Value);
+        }
+        return definesHash;
+    }
+
+    std::optional<std::string> preprocessShaderSource(const std::string& path, std::span<const ShaderDefine> defines) {
+        const ShaderSourceFile* root = loadShaderSourceFile(std::filesystem::path(path).lexically_normal().generic_string());
+        if (!root) {
+            return std::nullopt;
+        }
+
+        std::string source{};
+        std::vector<const ShaderSourceFile*> included{ root };
+        if (!appendShaderSource(*root, source, included)) {
+            return std::nullopt;
+        }
+
+        if (defines.empty()) {
+            return source;
+        }
+
+        // #version has to stay the first directive, so the defines follow it. It precedes any include of the file.
+        std::string defineBlock{};
+        for (const ShaderDefine& define : defines) {
+            defineBlock.append(std::format("#define {} {}\n", define.Name, define.Value));
+        }
+
+        size_t insertAt = 0;
+        if (root->VersionNextLine && root->VersionEnd <= root->Segments.front().Text.size()) {
+            insertAt = root->VersionEnd;
+            if (insertAt > 0 && source[insertAt - 1] != '\n') {
+                defineBlock.insert(defineBlock.begin(), '\n');
+            }
+            defineBlock.append(std::format("#line {} {}\n", root->VersionNextLine, root->Index));
+        } else {
+            defineBlock.append(std::format("#line 1 {}\n", root->Index));
+        }
+
+        source.insert(insertAt, defineBlock);
+        return source;
+    }
+
+    static bool isIdentifierChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    static std::string_view skipWhitespace(std::string_view text) {
+        const size_t start = text.find_first_not_of(" \t\r\n");
+        return start == std::string_view::npos ? std::string_view{} : text.substr(start);
+    }
+
+    static std::string_view readIdentifier(std::string_view& text) {
+        size_t length = 0;
+        while (length < text.size() && isIdentifierChar(text[length])) {
+            ++length;
+        }
+
+        const std::string_view identifier = text.substr(0, length);
+        text.remove_prefix(length);
+        return identifier;
+    }
+
+    static bool hasBindingQualifier(std::string_view qualifiers) {
+        for (size_t at = qualifiers.find("binding"); at != std::string_view::npos; at = qualifiers.find("binding", at + 1)) {
+            const size_t end = at + 7;
+            if ((at > 0 && isIdentifierChar(qualifiers[at - 1])) || (end < qualifiers.size() && isIdentifierChar(qualifiers[end]))) {
+                continue;
+            }
+
+            const std::string_view rest = skipWhitespace(qualifiers.substr(end));
+            if (!rest.empty() && rest.front() == '=') {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<uint64_t> findExplicitBlockBindings(std::string_view source) {
+        std::vector<uint64_t> blocks{};
+        for (size_t at = source.find("layout"); at != std::string_view::npos; at = source.find("layout", at + 1)) {
+            if (at > 0 && isIdentifierChar(source[at - 1])) {
+                continue;
+            }
+
+            std::string_view rest = skipWhitespace(source.substr(at + 6));
+            if (rest.empty() || rest.front() != '(') {
+                continue;
+            }
+
+            const size_t close = rest.find(')');
+            if (close == std::string_view::npos) {
+                break;
+            }
+
+            if (!hasBindingQualifier(rest.substr(1, close - 1))) {
+                continue;
+            }
+
+            // Other qualifiers may come between the layout and the uniform storage qualifier
+            rest = skipWhitespace(rest.substr(close + 1));
+            std::string_view word = readIdentifier(rest);
+            while (!word.empty() && word != "uniform") {
+                rest = skipWhitespace(rest);
+                word = readIdentifier(rest);
+            }
+
+            if (word != "uniform") {
+                continue;
+            }
+
+            rest = skipWhitespace(rest);
+            const std::string_view name = readIdentifier(rest);
+            rest = skipWhitespace(rest);
+            if (!name.empty() && !rest.empty() && rest.front() == '{') {
+                blocks.push_back(hash::hash64(name.data(), name.size()));
+            }
+        }
+
+        return blocks;
+    }
+
+    void freeShaderSourceCache() {
+        GShaderSourceCache.clear();
+    }
+} // namespace glass::gfx
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "optional"
+
+namespace glass::gfx {
+    /** Hash of the define set, independent of the order of the defines */
+    uint64_t calculateShaderDefinesHash(std::span<const ShaderDefine> defines);
+
+    /**
+     * Resolve #include directives of a shader file and inject the defines after its #version directive.
+     * Files are mapped and scanned for includes once, later permutations only concatenate the cached text.
+     * Each file is included at most once per shader. #line directives keep compiler logs pointing at the included files.
+     * @return Preprocessed source, empty if a file can't be opened
+     */
+    std::optional<std::string> preprocessShaderSource(const std::string& path, std::span<const ShaderDefine> defines);
+
+    /**
+     * Name hashes of the uniform blocks declared with a binding qualifier, like layout(std140, binding = 0) uniform Name { ... }.
+     * GL reports blocks without the qualifier as binding 0, so this tells an explicit binding 0 apart from none.
+     */
+    std::vector<uint64_t> findExplicitBlockBindings(std::string_view source);
+
+    void freeShaderSourceCache();
+} // namespace glass::gfx
@@ -0,0 +1,318 @@
+#include "glShader.h"
+#include "glInternal.h"
+
+#include "iostream"
+#include "algorithm"
+#include "tuple"
+#include "bit"
+#include "cstring"
+
+namespace glass::gfx {
+#if GLASS_CONTEXT_VERSION_MAJOR >= 4 && GLASS_CONTEXT_VERSION_MINOR >= 3
+    struct ResourceProperty {
+        GLenum Property;
+        int32_t ShaderResourceInfo::*Field;
+    };
+
+    static constexpr ResourceProperty MEMBER_PROPERTIES[] = {
+        { GL_BLOCK_INDEX, &ShaderResourceInfo::BlockIndex },
+        { GL_OFFSET, &ShaderResourceInfo::Offset },
+        { GL_ARRAY_SIZE, &ShaderResourceInfo::ArraySize },
+        { GL_ARRAY_STRIDE, &ShaderResourceInfo::ArrayStride },
+        { GL_MATRIX_STRIDE, &ShaderResourceInfo::MatrixStride },
+    };
+
+    static constexpr ResourceProperty BLOCK_PROPERTIES[] = {
+        { GL_BUFFER_BINDING, &ShaderResourceInfo::Binding },
+        { GL_BUFFER_DATA_SIZE, &ShaderResourceInfo::DataSize },
+    };
+
+    static constexpr ResourceProperty INPUT_PROPERTIES[] = {
+        { GL_LOCATION, &ShaderResourceInfo::Location },
+        { GL_ARRAY_SIZE, &ShaderResourceInfo::ArraySize },
+    };
+
+    static void appendProgramResources(uint32_t program, GLenum programInterface, EShaderResourceType type, std::vector<ShaderResourceInfo>& outResources) {
+        GLint count = 0;
+        GLint maxNameLength = 0;
+        glGetProgramInterfaceiv(program, programInterface, GL_ACTIVE_RESOURCES, &count);
+        glGetProgramInterfaceiv(program, programInterface, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+        const bool isBlock = type == ESRT_UniformBlock || type == ESRT_StorageBlock;
+        const bool hasGLType = !isBlock;
+        const bool hasLocation = type == ESRT_Uniform;
+        std::span<const ResourceProperty> properties = isBlock ? std::span<const ResourceProperty>(BLOCK_PROPERTIES)
+                                                       : type == ESRT_VertexInput ? std::span<const ResourceProperty>(INPUT_PROPERTIES)
+                                                                                  : std::span<const ResourceProperty>(MEMBER_PROPERTIES);
+
+        std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+        for (GLint index = 0; index < count; ++index) {
+            GLsizei length = 0;
+            glGetProgramResourceName(program, programInterface, index, maxNameLength, &length, name.data());
+
+            // Built-ins like gl_VertexID can't be bound by the application
+            if (name.starts_with("gl_")) {
+                continue;
+            }
+
+            ShaderResourceInfo info{};
+            info.Name.assign(name.data(), length);
+            info.Type = type;
+
+            GLenum queries[8]{};
+            GLint values[8]{};
+            GLsizei queryCount = 0;
+            for (const ResourceProperty& property : properties) {
+                queries[queryCount++] = property.Property;
+            }
+            if (hasGLType) {
+                queries[queryCount++] = GL_TYPE;
+            }
+            if (hasLocation) {
+                queries[queryCount++] = GL_LOCATION;
+            }
+
+            glGetProgramResourceiv(program, programInterface, index, queryCount, queries, queryCount, nullptr, values);
+
+            GLsizei value = 0;
+            for (const ResourceProperty& property : properties) {
+                info.*property.Field = values[value++];
+            }
+            if (hasGLType) {
+                info.GLType = static_cast<uint32_t>(values[value++]);
+            }
+            if (hasLocation) {
+                info.Location = values[value++];
+            }
+            if (isBlock) {
+                info.BlockIndex = index;
+            }
+
+            outResources.push_back(std::move(info));
+        }
+    }
+#endif
+
+    void ShaderProgram::reflect() {
+#if GLASS_CONTEXT_VERSION_MAJOR >= 4 && GLASS_CONTEXT_VERSION_MINOR >= 3
+        appendProgramResources(m_Id, GL_UNIFORM, ESRT_Uniform, m_Resources);
+        appendProgramResources(m_Id, GL_UNIFORM_BLOCK, ESRT_UniformBlock, m_Resources);
+        appendProgramResources(m_Id, GL_SHADER_STORAGE_BLOCK, ESRT_StorageBlock, m_Resources);
+        appendProgramResources(m_Id, GL_BUFFER_VARIABLE, ESRT_BufferVariable, m_Resources);
+        appendProgramResources(m_Id, GL_PROGRAM_INPUT, ESRT_VertexInput, m_Resources);
+
+        std::ranges::sort(m_Resources, [](const ShaderResourceInfo& a, const ShaderResourceInfo& b) { return std::tie(a.Type, a.Name) < std::tie(b.Type, b.Name); });
+
+        // Arrays are reported as "name[0]". Every element gets an entry of its own and the bare name maps to the first one.
+        std::vector<std::pair<uint64_t, UniformLocation>> uniforms;
+        for (const ShaderResourceInfo& resource : m_Resources) {
+            if (resource.Type != ESRT_Uniform || resource.Location == -1) {
+                continue;
+            }
+
+            const std::string_view name = resource.Name;
+            const UniformLocation uniform{ resource.Location, resource.GLType };
+            uniforms.emplace_back(hash::hash64(name.data(), name.size()), uniform);
+
+            if (name.ends_with("[0]")) {
+                const std::string_view base = name.substr(0, name.size() - 3);
+                uniforms.emplace_back(hash::hash64(base.data(), base.size()), uniform);
+
+                for (int32_t element = 1; element < resource.ArraySize; ++element) {
+                    const std::string elementName = std::format("{}[{}]", base, element);
+                    uniforms.emplace_back(hash::hash64(elementName.data(), elementName.size()), UniformLocation{ resource.Location + element, resource.GLType });
+                }
+            }
+        }
+
+        // At most half full, so probe sequences stay short and there is always an empty slot to end them
+        const uint64_t capacity = std::bit_ceil(std::max<uint64_t>(uniforms.size() * 2, 8));
+        m_UniformTable.assign(capacity, {});
+        m_UniformTableMask = capacity - 1;
+        for (const auto& [nameHash, uniform] : uniforms) {
+            insertUniform(nameHash, uniform);
+        }
+
+        allocateUniformShadows();
+        m_Reflected = true;
+#endif
+    }
+
+    // Bytes of the largest value setUniform writes for a uniform type
+    static uint32_t getUniformShadowSize(uint32_t type) {
+        switch (type) {
+            case GL_FLOAT_VEC2:
+            case GL_INT_VEC2:
+            case GL_UNSIGNED_INT_VEC2:
+            case GL_BOOL_VEC2:
+                return 8;
+            case GL_FLOAT_VEC3:
+            case GL_INT_VEC3:
+            case GL_UNSIGNED_INT_VEC3:
+            case GL_BOOL_VEC3:
+                return 12;
+            case GL_FLOAT_VEC4:
+            case GL_INT_VEC4:
+            case GL_UNSIGNED_INT_VEC4:
+            case GL_BOOL_VEC4:
+                return 16;
+            case GL_FLOAT_MAT3:
+                return sizeof(glm::mat3);
+            case GL_FLOAT_MAT4:
+                return sizeof(glm::mat4);
+            case GL_DOUBLE:
+            case GL_FLOAT_MAT2:
+            case GL_FLOAT_MAT2x3:
+            case GL_FLOAT_MAT2x4:
+            case GL_FLOAT_MAT3x2:
+            case GL_FLOAT_MAT3x4:
+            case GL_FLOAT_MAT4x2:
+            case GL_FLOAT_MAT4x3:
+                // Not settable through setUniform, writes are never skipped
+                return 0;
+            default:
+                // Scalars, booleans, samplers and images
+                return 4;
+        }
+    }
+
+    void ShaderProgram::allocateUniformShadows() {
+        uint32_t dataSize = 0;
+        for (const UniformEntry& entry : m_UniformTable) {
+            const int32_t location = entry.Uniform.Location;
+            if (location == -1) {
+                continue;
+            }
+
+            if (static_cast<size_t>(location) >= m_UniformShadows.size()) {
+                m_UniformShadows.resize(location + 1);
+            }
+
+            // Bare array names share the location of the first element
+            UniformShadow& shadow = m_UniformShadows[location];
+            if (shadow.Size == 0) {
+                shadow.Size = getUniformShadowSize(entry.Uniform.Type);
+                shadow.Offset = dataSize;
+                dataSize += shadow.Size;
+            }
+        }
+
+        m_UniformShadowData.resize(dataSize);
+    }
+
+    bool ShaderProgram::updateUniformShadow(int32_t location, const void* data, uint32_t size) const {
+        if (static_cast<size_t>(location) >= m_UniformShadows.size() || size > m_UniformShadows[location].Size) {
+            return true;
+        }
+
+        UniformShadow& shadow = m_UniformShadows[location];
+        uint8_t* value = m_UniformShadowData.data() + shadow.Offset;
+        if (shadow.Written && std::memcmp(value, data, size) == 0) {
+            return false;
+        }
+
+        std::memcpy(value, data, size);
+        shadow.Written = true;
+        return true;
+    }
+
+    bool ShaderProgram::shadowUniform(int32_t location, const void* data, uint32_t size, uint32_t count) const {
+        // GL ignores writes to missing or optimized out uniforms, so they are neither uploaded nor counted
+        if (location < 0) {
+            return false;
+        }
+
+        // Every element is compared, so the shadows of all of them stay in sync with what is uploaded
+        bool changed = false;
+        const uint8_t* element = static_cast<const uint8_t*>(data);
+        for (uint32_t i = 0; i < count; ++i, element += size) {
+            changed |= updateUniformShadow(location + static_cast<int32_t>(i), element, size);
+        }
+
+        ++(changed ? m_UploadStats.Issued : m_UploadStats.Skipped);
+        return changed;
+    }
+
+    UniformUploadStats getUniformUploadStats(const ShaderProgram* program) {
+        return program->getUploadStats();
+    }
+
+    void resetUniformUploadStats(const ShaderProgram* program) {
+        program->resetUploadStats();
+    }
+
+    void ShaderProgram::insertUniform(uint64_t hash, UniformLocation uniform) {
+        uint64_t slot = hash & m_UniformTableMask;
+        while (m_UniformTable[slot].Uniform.Location != -1 && m_UniformTable[slot].NameHash != hash) {
+            slot = (slot + 1) & m_UniformTableMask;
+        }
+
+        m_UniformTable[slot] = { hash, uniform };
+    }
+
+    const ShaderResourceInfo* ShaderProgram::findResource(EShaderResourceType type, std::string_view name) const {
+        using Key = std::tuple<EShaderResourceType, std::string_view>;
+        const auto iter = std::ranges::lower_bound(m_Resources, Key(type, name), {}, [](const ShaderResourceInfo& resource) { return Key(resource.Type, resource.Name); });
+
+        if (iter != m_Resources.end() && iter->Type == type && iter->Name == name) {
+            return &*iter;
+        }
+
+        return nullptr;
+    }
+
+    std::span<const ShaderResourceInfo> getShaderProgramResources(const ShaderProgram* program) {
+        return program->getResources();
+    }
+
+    const ShaderResourceInfo* findShaderProgramResource(const ShaderProgram* program, EShaderResourceType type, const char* name) {
+        return program->findResource(type, name);
+    }
+
+    // Members of blocks with an instance name are reported as "Block.member"
+    static const ShaderResourceInfo* findBlockMember(const ShaderProgram* program, const ShaderResourceInfo& block, const char* member) {
+        const EShaderResourceType memberType = block.Type == ESRT_UniformBlock ? ESRT_Uniform : ESRT_BufferVariable;
+        const ShaderResourceInfo* found = program->findResource(memberType, member);
+        if (!found || found->BlockIndex != block.BlockIndex) {
+            found = program->findResource(memberType, std::format("{}.{}", block.Name, member));
+        }
+
+        return found && found->BlockIndex == block.BlockIndex ? found : nullptr;
+    }
+
+    bool validateBlockLayout(const ShaderProgram* program, const char* blockName, uint64_t structSize, std::span<const BlockMemberLayout> members) {
+        if (!program->isReflected()) {
+            std::cout << std::format("GLASS warning: Block layouts can't be validated without program reflection (GL 4.3).");
+            return false;
+        }
+
+        const ShaderResourceInfo* block = program->findResource(ESRT_UniformBlock, blockName);
+        if (!block) {
+            block = program->findResource(ESRT_StorageBlock, blockName);
+        }
+
+        if (!block) {
+            std::cout << std::format("GLASS error: Program has no active block with name: {}", blockName);
+            return false;
+        }
+
+        bool valid = true;
+        if (structSize < static_cast<uint64_t>(block->DataSize)) {
+            std::cout << std::format("GLASS error: Block {} needs {} bytes, but the CPU struct has {}.", blockName, block->DataSize, structSize);
+            valid = false;
+        }
+
+        for (const BlockMemberLayout& member : members) {
+            const ShaderResourceInfo* variable = findBlockMember(program, *block, member.Name);
+            if (!variable) {
+                std::cout << std::format("GLASS error: Block {} has no active member with name: {}", blockName, member.Name);
+                valid = false;
+            } else if (variable->Offset != static_cast<int32_t>(member.Offset)) {
+                std::cout << std::format("GLASS error: Member {} of block {} is at offset {}, but the CPU struct has it at {}.", member.Name, blockName, variable->Offset, member.Offset);
+                valid = false;
+            }
+        }
+
+        return valid;
+    }
+} // namespace glass::gfx
@@ -0,0 +1,112 @@
+#include "glStagingRing.h"
+
+#include "cassert"
+
+namespace glass::gfx {
+    StagingRing::StagingRing(GLenum target, uint32_t slotCount, uint32_t maxSlotCount)
+        : m_Target(target)
+        , m_Slots(slotCount)
+        , m_MaxSlotCount(maxSlotCount) {
+        assert(slotCount > 0);
+        for (Slot& slot : m_Slots) {
+            glGenBuffers(1, &slot.BufferID);
+        }
+    }
+
+    StagingRing::~StagingRing() {
+        for (Slot& slot : m_Slots) {
+            if (slot.Fence) {
+                glDeleteSync(slot.Fence);
+            }
+            glDeleteBuffers(1, &slot.BufferID);
+        }
+    }
+
+    uint32_t StagingRing::acquireSlot(uint64_t size) {
+        uint32_t index = m_NextSlot;
+        if (getSlotCount() < m_MaxSlotCount && !isSlotReady(index)) {
+            // The new slot goes before the busy one, which stays the oldest in the ring
+            Slot added{};
+            glGenBuffers(1, &added.BufferID);
+            m_Slots.insert(m_Slots.begin() + index, added);
+        }
+
+        m_NextSlot = (index + 1) % getSlotCount();
+        waitSlot(index);
+
+        Slot& slot = m_Slots[index];
+        if (slot.Capacity < size) {
+            glBindBuffer(m_Target, slot.BufferID);
+            glBufferData(m_Target, static_cast<GLsizeiptr>(size), nullptr, m_Target == GL_PIXEL_PACK_BUFFER ? GL_STREAM_READ : GL_STREAM_DRAW);
+            glBindBuffer(m_Target, 0);
+            slot.Capacity = size;
+        }
+
+        return index;
+    }
+
+    void* StagingRing::mapSlotForWrite(uint32_t slot, uint64_t size) {
+        assert(size <= m_Slots[slot].Capacity);
+
+        // The slot fence was waited for in acquireSlot, so the driver does not need to synchronize again.
+        glBindBuffer(m_Target, m_Slots[slot].BufferID);
+        return glMapBufferRange(m_Target, 0, static_cast<GLsizeiptr>(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+
+    const void* StagingRing::mapSlotForRead(uint32_t slot, uint64_t size) {
+        assert(size <= m_Slots[slot].Capacity);
+
+        glBindBuffer(m_Target, m_Slots[slot].BufferID);
+        return glMapBufferRange(m_Target, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+    }
+
+    void StagingRing::unmapSlot(uint32_t slot) {
+        glBindBuffer(m_Target, m_Slots[slot].BufferID);
+        glUnmapBuffer(m_Target);
+        glBindBuffer(m_Target, 0);
+    }
+
+    void StagingRing::fenceSlot(uint32_t slot) {
+        Slot& target = m_Slots[slot];
+        if (target.Fence) {
+            glDeleteSync(target.Fence);
+        }
+        target.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    bool StagingRing::isSlotReady(uint32_t slot) {
+        Slot& target = m_Slots[slot];
+        if (!target.Fence) {
+            return true;
+        }
+
+        const GLenum result = glClientWaitSync(target.Fence, 0, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            glDeleteSync(target.Fence);
+            target.Fence = nullptr;
+            return true;
+        }
+
+        return false;
+    }
+
+    void StagingRing::waitSlot(uint32_t slot) {
+        Slot& target = m_Slots[slot];
+        if (!target.Fence) {
+            return;
+        }
+
+        // Flush on the first wait, otherwise the fence might never be submitted.
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        while (true) {
+            const GLenum result = glClientWaitSync(target.Fence, flags, UINT64_C(1000000000));
+            if (result != GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+            flags = 0;
+        }
+
+        glDeleteSync(target.Fence);
+        target.Fence = nullptr;
+    }
+} // namespace glass::gfx
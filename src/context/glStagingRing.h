@@ -0,0 +1,61 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "glad/glad.h"
+
+namespace glass::gfx {
+    /**
+     * Ring of pixel buffer objects used to move data between client memory and GL without stalling the pipeline.
+     * Every slot is guarded by a fence, so a slot is only reused after the GPU is done with it.
+     * A growable ring inserts a new slot instead of waiting when the next slot is still in flight. Growing shifts the
+     * indices of older slots, so growable rings suit slots that are acquired, used and fenced in one go.
+     */
+    class StagingRing {
+    public:
+        /** @param maxSlotCount Number of slots the ring may grow to, the ring never grows if it's not above slotCount */
+        StagingRing(GLenum target, uint32_t slotCount, uint32_t maxSlotCount = 0);
+        ~StagingRing();
+
+        StagingRing(const StagingRing&) = delete;
+        StagingRing& operator=(const StagingRing&) = delete;
+
+        /**
+         * Take the next slot in the ring and make sure it can hold size bytes. If the slot is still in flight,
+         * a new slot is added while the ring is below its maximum size, else this waits for the GPU.
+         */
+        uint32_t acquireSlot(uint64_t size);
+
+        /** Map the slot for writing. The whole previous content is discarded. */
+        void* mapSlotForWrite(uint32_t slot, uint64_t size);
+
+        /** Map the slot for reading. The slot must be ready. */
+        const void* mapSlotForRead(uint32_t slot, uint64_t size);
+        void unmapSlot(uint32_t slot);
+
+        /** Insert a fence after the commands that use the slot. */
+        void fenceSlot(uint32_t slot);
+
+        /** Check without blocking whether the GPU finished the commands fenced for the slot. */
+        bool isSlotReady(uint32_t slot);
+
+        /** Block until the GPU finished the commands fenced for the slot. */
+        void waitSlot(uint32_t slot);
+
+        inline GLenum getTarget() const { return m_Target; }
+        inline uint32_t getSlotCount() const { return static_cast<uint32_t>(m_Slots.size()); }
+        inline uint32_t getBufferID(uint32_t slot) const { return m_Slots[slot].BufferID; }
+        inline void setMaxSlotCount(uint32_t maxSlotCount) { m_MaxSlotCount = maxSlotCount; }
+
+    private:
+        struct Slot {
+            uint32_t BufferID{};
+            uint64_t Capacity{};
+            GLsync Fence{};
+        };
+
+        GLenum m_Target{};
+        std::vector<Slot> m_Slots{};
+        uint32_t m_NextSlot{};
+        uint32_t m_MaxSlotCount{};
+    };
+} // namespace glass::gfx
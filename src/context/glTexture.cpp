@@ -1,7 +1,12 @@
 #include "glass/glass.h"
 #include "glTexture.h"
 #include "glInternal.h"
+#include "glStagingRing.h"
+#include "glSampler.h"
 #include "cassert"
+#include "cstring"
+#include "algorithm"
+#include "vector"
 
 namespace glass::gfx {
     void initAs1DTexture(uint32_t id, const TextureSpec& spec) {
@@ -22,50 +27,214 @@ namespace glass::gfx {
         GLCALL(glBindTexture(GL_TEXTURE_3D, 0));
     }
 
+    void initAs2DArrayTexture(uint32_t id, const TextureSpec& spec) {
+        GLCALL(glBindTexture(GL_TEXTURE_2D_ARRAY, id));
+        GLCALL(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, toGLInternalFormat(spec.Format), spec.Width, spec.Height, spec.Depth, 0, toGLFormat(spec.Format), toGLDataTypeFromFormat(spec.Format), spec.InitialData));
+        GLCALL(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+    }
+
     // void initAsCubeTexture(uint32_t id, const TextureSpec& spec) {
 
     //}
 
-    ResourceID createTexture(const TextureSpec& spec) {
-        TextureHandle outHandle{ ResourceID::Null };
-        outHandle.Id = 0;
-        outHandle.Type = spec.Type;
-        outHandle.Format = spec.Format;
+    static void texSubImage(const TextureHandle& handle, uint32_t mipLevel, int32_t x, int32_t y, int32_t z, int32_t width, int32_t height, int32_t depth, const void* pixels) {
+        const GLint level = static_cast<GLint>(mipLevel);
 
-        GLCALL(glGenTextures(1, &outHandle.TextureID));
+        if (isCompressedPixelFormat(handle.Format)) {
+            assert((handle.Type == ETT_Texture2D || handle.Type == ETT_Texture2DArray) && "Compressed formats are only supported for 2D and 2D array textures");
+            assert(x % 4 == 0 && y % 4 == 0 && "Compressed texture regions must be aligned to 4x4 blocks");
+
+            if (handle.Type == ETT_Texture2DArray) {
+                const GLsizei imageSize = static_cast<GLsizei>(getImageSizeInBytes(handle.Format, width, height, depth));
+                GLCALL(glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, x, y, z, width, height, depth, toGLInternalFormat(handle.Format), imageSize, pixels));
+            } else {
+                const GLsizei imageSize = static_cast<GLsizei>(getImageSizeInBytes(handle.Format, width, height));
+                GLCALL(glCompressedTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, toGLInternalFormat(handle.Format), imageSize, pixels));
+            }
+            return;
+        }
+
+        const GLenum format = toGLFormat(handle.Format);
+        const GLenum dataType = toGLDataTypeFromFormat(handle.Format);
+
+        switch (handle.Type) {
+            case ETT_Texture1D:
+                GLCALL(glTexSubImage1D(GL_TEXTURE_1D, level, x, width, format, dataType, pixels));
+                break;
+            case ETT_Texture2D:
+                GLCALL(glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, dataType, pixels));
+                break;
+            case ETT_Texture3D:
+                GLCALL(glTexSubImage3D(GL_TEXTURE_3D, level, x, y, z, width, height, depth, format, dataType, pixels));
+                break;
+            case ETT_TextureCube:
+                assert(false && "Cube textures are currently unsupported");
+                break;
+            case ETT_Texture2DArray:
+                GLCALL(glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, x, y, z, width, height, depth, format, dataType, pixels));
+                break;
+        }
+    }
+
+    // Immutable storage for mip levels supplied up front. Compressed textures always take this path.
+    static void initWithStorage(const TextureHandle& handle, const TextureSpec& spec, uint32_t mipLevels, const void* const* mipData) {
         const GLenum textureType = toGLTextureType(spec.Type);
+        const GLenum internalFormat = toGLInternalFormat(spec.Format);
 
+        GLCALL(glBindTexture(textureType, handle.TextureID));
         switch (spec.Type) {
             case ETT_Texture1D:
-                initAs1DTexture(outHandle.TextureID, spec);
+                GLCALL(glTexStorage1D(GL_TEXTURE_1D, static_cast<GLsizei>(mipLevels), internalFormat, spec.Width));
                 break;
             case ETT_Texture2D:
-                initAs2DTexture(outHandle.TextureID, spec);
+                GLCALL(glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(mipLevels), internalFormat, spec.Width, spec.Height));
                 break;
             case ETT_Texture3D:
-                initAs3DTexture(outHandle.TextureID, spec);
+                GLCALL(glTexStorage3D(GL_TEXTURE_3D, static_cast<GLsizei>(mipLevels), internalFormat, spec.Width, spec.Height, spec.Depth));
                 break;
             case ETT_TextureCube:
-                // initAsCubeTexture(outHandle.TextureID, spec);
                 assert(false && "Cube textures are currently unsupported");
-                return ResourceID::Null;
+                break;
+            case ETT_Texture2DArray:
+                GLCALL(glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(mipLevels), internalFormat, spec.Width, spec.Height, spec.Depth));
                 break;
         }
 
-        GLCALL(glBindTexture(textureType, outHandle.TextureID));
-        GLCALL(glTexParameteri(textureType, GL_TEXTURE_MIN_FILTER, toGLFilter(spec.Sampler.MinFilter)));
-        GLCALL(glTexParameteri(textureType, GL_TEXTURE_MAG_FILTER, toGLFilter(spec.Sampler.MagFilter)));
-        GLCALL(glTexParameteri(textureType, GL_TEXTURE_WRAP_S, toGLWrapMode(spec.Sampler.WrapModeS)));
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        for (uint32_t level = 0; level < mipLevels; ++level) {
+            if (!mipData[level]) {
+                continue;
+            }
+
+            const int32_t width = std::max(spec.Width >> level, 1);
+            const int32_t height = spec.Type > ETT_Texture1D ? std::max(spec.Height >> level, 1) : 1;
+            // Array layers don't shrink with the mip level
+            int32_t depth = 1;
+            if (spec.Type == ETT_Texture3D) {
+                depth = std::max(spec.Depth >> level, 1);
+            } else if (spec.Type == ETT_Texture2DArray) {
+                depth = spec.Depth;
+            }
+            texSubImage(handle, level, 0, 0, 0, width, height, depth, mipData[level]);
+        }
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        GLCALL(glBindTexture(textureType, 0));
+    }
+
+    // Like the other binding caches (image, sampler, uniform and storage buffer bindings) this only knows bindings made through glass.
+    // Slots past the cache size are not tracked and always rebound.
+    static constexpr uint32_t MAX_CACHED_TEXTURE_UNITS = 32;
+    static constexpr uint32_t UNKNOWN_TEXTURE = UINT32_MAX;
+    static uint32_t GBoundTextures[MAX_CACHED_TEXTURE_UNITS]{};
+    static uint32_t GActiveTextureUnit = 0;
+
+    void invalidateActiveTextureUnit() {
+        if (GActiveTextureUnit < MAX_CACHED_TEXTURE_UNITS) {
+            GBoundTextures[GActiveTextureUnit] = UNKNOWN_TEXTURE;
+        }
+    }
+
+    void bindTextureUnit(uint32_t unit, ResourceID texture) {
+        const TextureHandle handle{ texture };
+        if (unit < MAX_CACHED_TEXTURE_UNITS) {
+            if (GBoundTextures[unit] == handle.TextureID) {
+                return;
+            }
+
+            GBoundTextures[unit] = handle.TextureID;
+        }
+
+        if (GActiveTextureUnit != unit) {
+            GLCALL(glActiveTexture(GL_TEXTURE0 + unit));
+            GActiveTextureUnit = unit;
+        }
+
+        // Null carries no texture type, unbind the 2D target
+        GLCALL(glBindTexture(texture == ResourceID::Null ? GL_TEXTURE_2D : toGLTextureType(handle.Type), handle.TextureID));
+    }
+
+    void bindTextures(uint32_t firstUnit, std::span<const ResourceID> textures) {
+        const BindTexturesFn bindTexturesMulti = getMultiBindFunctions().BindTextures;
+        if (!bindTexturesMulti) {
+            for (size_t i = 0; i < textures.size(); ++i) {
+                bindTextureUnit(firstUnit + static_cast<uint32_t>(i), textures[i]);
+            }
+            return;
+        }
+
+        static std::vector<GLuint> textureIDs{};
+        textureIDs.resize(textures.size());
+
+        // Rebind the smallest range covering every changed unit
+        size_t first = textures.size();
+        size_t last = 0;
+        for (size_t i = 0; i < textures.size(); ++i) {
+            const uint32_t unit = firstUnit + static_cast<uint32_t>(i);
+            textureIDs[i] = getTextureID(textures[i]);
+            if (unit < MAX_CACHED_TEXTURE_UNITS) {
+                if (GBoundTextures[unit] == textureIDs[i]) {
+                    continue;
+                }
+
+                GBoundTextures[unit] = textureIDs[i];
+            }
 
-        if (spec.Type > ETT_Texture1D) {
-            GLCALL(glTexParameteri(textureType, GL_TEXTURE_WRAP_T, toGLWrapMode(spec.Sampler.WrapModeT)));
+            first = std::min(first, i);
+            last = i;
         }
 
-        if (spec.Type == ETT_Texture3D) {
-            GLCALL(glTexParameteri(textureType, GL_TEXTURE_WRAP_R, toGLWrapMode(spec.Sampler.WrapModeU)));
+        if (first < textures.size()) {
+            GLCALL(bindTexturesMulti(firstUnit + static_cast<GLuint>(first), static_cast<GLsizei>(last - first + 1), textureIDs.data() + first));
         }
+    }
+
+    ResourceID createTexture(const TextureSpec& spec) {
+        invalidateActiveTextureUnit();
+
+        TextureHandle outHandle{ ResourceID::Null };
+        outHandle.Id = 0;
+        outHandle.Type = spec.Type;
+        outHandle.Format = spec.Format;
+
+        GLCALL(glGenTextures(1, &outHandle.TextureID));
+        const GLenum textureType = toGLTextureType(spec.Type);
+
+        const bool compressed = isCompressedPixelFormat(spec.Format);
+        if (spec.MipData) {
+            const uint32_t fullChain = getMipLevelCount(spec.Width, spec.Type > ETT_Texture1D ? spec.Height : 1, spec.Type == ETT_Texture3D ? spec.Depth : 1);
+            const uint32_t mipLevels = spec.MipLevels == 0 ? fullChain : std::min(spec.MipLevels, fullChain);
+            initWithStorage(outHandle, spec, mipLevels, spec.MipData);
+        } else if (compressed) {
+            initWithStorage(outHandle, spec, 1, &spec.InitialData);
+        } else {
+            switch (spec.Type) {
+                case ETT_Texture1D:
+                    initAs1DTexture(outHandle.TextureID, spec);
+                    break;
+                case ETT_Texture2D:
+                    initAs2DTexture(outHandle.TextureID, spec);
+                    break;
+                case ETT_Texture3D:
+                    initAs3DTexture(outHandle.TextureID, spec);
+                    break;
+                case ETT_TextureCube:
+                    // initAsCubeTexture(outHandle.TextureID, spec);
+                    assert(false && "Cube textures are currently unsupported");
+                    return ResourceID::Null;
+                    break;
+                case ETT_Texture2DArray:
+                    initAs2DArrayTexture(outHandle.TextureID, spec);
+                    break;
+            }
+        }
+
+        GLCALL(glBindTexture(textureType, outHandle.TextureID));
+        applySamplerSpec(
+            spec.Sampler,
+            [textureType](GLenum parameter, GLint value) { GLCALL(glTexParameteri(textureType, parameter, value)); },
+            [textureType](GLenum parameter, GLfloat value) { GLCALL(glTexParameterf(textureType, parameter, value)); });
 
-        if (spec.GenerateMipmaps) {
+        if (spec.GenerateMipmaps && !spec.MipData && !compressed) {
             GLCALL(glGenerateMipmap(textureType));
         }
         GLCALL(glBindTexture(textureType, 0));
@@ -73,13 +242,126 @@ namespace glass::gfx {
         return static_cast<ResourceID>(outHandle.Id);
     }
 
+    struct ImageBinding {
+        uint32_t TextureID{};
+        uint32_t MipLevel{};
+        int32_t Layer{};
+        EImageAccess Access{};
+    };
+
+    // GL 4.3 guarantees only 8 image units
+    static constexpr uint32_t MAX_CACHED_IMAGE_UNITS = 8;
+    static ImageBinding GImageBindings[MAX_CACHED_IMAGE_UNITS]{};
+
+    void resetTextureBindingCache() {
+        std::ranges::fill(GBoundTextures, 0u);
+        GActiveTextureUnit = 0;
+        std::ranges::fill(GImageBindings, ImageBinding{});
+    }
+
+    void bindImageTexture(ResourceID texture, uint32_t unit, EImageAccess access, uint32_t mipLevel, int32_t layer) {
+        const TextureHandle handle{ texture };
+        assert(handle.Format != EPF_RGB8 && handle.Format != EPF_SRGBA8 && !isCompressedPixelFormat(handle.Format) && "Format is not supported by image load/store");
+
+        if (unit < MAX_CACHED_IMAGE_UNITS) {
+            ImageBinding& cached = GImageBindings[unit];
+            if (cached.TextureID == handle.TextureID && cached.MipLevel == mipLevel && cached.Layer == layer && cached.Access == access) {
+                return;
+            }
+
+            cached = { handle.TextureID, mipLevel, layer, access };
+        }
+
+        const bool layered = layer == ALL_LAYERS && handle.Type != ETT_Texture1D && handle.Type != ETT_Texture2D;
+        GLCALL(glBindImageTexture(
+            unit,
+            handle.TextureID,
+            static_cast<GLint>(mipLevel),
+            layered ? GL_TRUE : GL_FALSE,
+            layer == ALL_LAYERS ? 0 : layer,
+            toGLImageAccess(access),
+            toGLInternalFormat(handle.Format)));
+    }
+
     void destroyTexture(ResourceID id) {
         uint32_t texID = getTextureID(id);
         if (texID != 0) {
+            // Deleted textures are unbound from image units by GL.
+            for (ImageBinding& binding : GImageBindings) {
+                if (binding.TextureID == texID) {
+                    binding = {};
+                }
+            }
+
+            // Deleted textures are unbound from texture units by GL as well.
+            for (uint32_t& bound : GBoundTextures) {
+                if (bound == texID) {
+                    bound = 0;
+                }
+            }
+
+            forgetStreamingTexture(texID);
             GLCALL(glDeleteTextures(1, &texID));
         }
     }
 
+    static constexpr uint32_t TEXTURE_UPLOAD_RING_SIZE = 4;
+    static uint32_t GTextureUploadRingLimit = 64;
+    static std::unique_ptr<StagingRing> GTextureUploadRing{};
+
+    void setTextureUploadRingLimit(uint32_t maxUploads) {
+        assert(maxUploads > 0);
+        GTextureUploadRingLimit = maxUploads;
+        if (GTextureUploadRing) {
+            GTextureUploadRing->setMaxSlotCount(maxUploads);
+        }
+    }
+
+    void freeTextureUploadRing() {
+        GTextureUploadRing.reset();
+    }
+
+    void writeTextureData(ResourceID texture, uint32_t mipLevel, int32_t x, int32_t y, int32_t z, int32_t width, int32_t height, int32_t depth, const void* data, bool async) {
+        const TextureHandle handle{ texture };
+        assert(data && width > 0 && height > 0 && depth > 0);
+
+        invalidateActiveTextureUnit();
+        const GLenum textureType = toGLTextureType(handle.Type);
+        GLCALL(glBindTexture(textureType, handle.TextureID));
+
+        // Rows are tightly packed regardless of the pixel size
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+        if (async) {
+            if (!GTextureUploadRing) {
+                GTextureUploadRing = std::make_unique<StagingRing>(GL_PIXEL_UNPACK_BUFFER, std::min(TEXTURE_UPLOAD_RING_SIZE, GTextureUploadRingLimit), GTextureUploadRingLimit);
+            }
+
+            const uint64_t size = getImageSizeInBytes(handle.Format, width, height, depth);
+            const uint32_t slot = GTextureUploadRing->acquireSlot(size);
+
+            void* mapped = GTextureUploadRing->mapSlotForWrite(slot, size);
+            std::memcpy(mapped, data, size);
+            GTextureUploadRing->unmapSlot(slot);
+
+            // With a pixel unpack buffer bound the pointer is an offset into the buffer.
+            GLCALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, GTextureUploadRing->getBufferID(slot)));
+            texSubImage(handle, mipLevel, x, y, z, width, height, depth, nullptr);
+            GLCALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+            GTextureUploadRing->fenceSlot(slot);
+        } else {
+            texSubImage(handle, mipLevel, x, y, z, width, height, depth, data);
+        }
+
+        GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        GLCALL(glBindTexture(textureType, 0));
+    }
+
+    bool isCompressedPixelFormat(EPixelFormat format) {
+        return getCompressedBlockSize(format) != 0;
+    }
+
     uint32_t getOpenGLTextureID(ResourceID texture) {
         return getTextureID(texture);
     }
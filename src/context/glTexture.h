@@ -25,4 +25,20 @@ namespace glass::gfx {
     inline EPixelFormat getTexturePixelFormat(ResourceID id) {
         return TextureHandle(id).Format;
     }
+
+    /** Bind a texture to a texture unit through the unit cache */
+    void bindTextureUnit(uint32_t unit, ResourceID texture);
+
+    /** Call before binding textures for editing. The edit changes the active unit behind the unit cache. */
+    void invalidateActiveTextureUnit();
+
+    void freeTextureUploadRing();
+
+    /** Forget the cached unit bindings, which refer to objects of the destroyed context */
+    void resetTextureBindingCache();
+
+    /** Drop streaming state of a texture that is being destroyed */
+    void forgetStreamingTexture(uint32_t textureID);
+
+    void freeTextureStreaming();
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "glass/glass.h"
+#include "glInternal.h"
+#include "io/mappedFile.h"
+#include "iostream"
+#include "format"
+#include "algorithm"
+#include "cstring"
+#include "vector"
+
+namespace glass::gfx {
+    struct LoadedImage {
+        EPixelFormat Format{ EPF_Undefined };
+        int32_t Width{};
+        int32_t Height{};
+
+        /** Pointers into the file mapping, finest level first */
+        std::vector<const void*> Levels;
+    };
+
+    template<typename T>
+    static T readValue(const uint8_t* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    static bool isLevelInFile(const io::MappedFile& file, uint64_t offset, uint64_t size) {
+        return offset <= file.getSize() && size <= file.getSize() - offset;
+    }
+
+    /**
+     * KTX2
+     */
+    static constexpr uint8_t KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    static constexpr uint64_t KTX2_HEADER_SIZE = 80;
+    static constexpr uint64_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+
+    static EPixelFormat fromVkFormat(uint32_t vkFormat) {
+        switch (vkFormat) {
+            case 23: // VK_FORMAT_R8G8B8_UNORM
+                return EPF_RGB8;
+            case 37: // VK_FORMAT_R8G8B8A8_UNORM
+                return EPF_RGBA8;
+            case 43: // VK_FORMAT_R8G8B8A8_SRGB
+                return EPF_SRGBA8;
+            case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+            case 133: // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+                return EPF_BC1;
+            case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+                return EPF_BC3;
+            case 139: // VK_FORMAT_BC4_UNORM_BLOCK
+                return EPF_BC4;
+            case 141: // VK_FORMAT_BC5_UNORM_BLOCK
+                return EPF_BC5;
+            case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+                return EPF_BC7;
+            case 147: // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+                return EPF_ETC2_RGB8;
+            case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+                return EPF_ETC2_RGBA8;
+        }
+
+        return EPF_Undefined;
+    }
+
+    static bool parseKTX2(const io::MappedFile& file, LoadedImage& image) {
+        const uint8_t* data = file.getData();
+        if (file.getSize() < KTX2_HEADER_SIZE) {
+            return false;
+        }
+
+        const uint32_t vkFormat = readValue<uint32_t>(data + 12);
+        const uint32_t width = readValue<uint32_t>(data + 20);
+        const uint32_t height = readValue<uint32_t>(data + 24);
+        const uint32_t depth = readValue<uint32_t>(data + 28);
+        const uint32_t layerCount = readValue<uint32_t>(data + 32);
+        const uint32_t faceCount = readValue<uint32_t>(data + 36);
+        const uint32_t levelCount = std::max(readValue<uint32_t>(data + 40), 1u);
+        const uint32_t supercompression = readValue<uint32_t>(data + 44);
+
+        if (depth > 1 || layerCount > 1 || faceCount != 1 || supercompression != 0 || height == 0) {
+            std::cout << std::format("GLASS error: Only plain 2D KTX2 textures without supercompression are supported.");
+            return false;
+        }
+
+        image.Format = fromVkFormat(vkFormat);
+        image.Width = static_cast<int32_t>(width);
+        image.Height = static_cast<int32_t>(height);
+        if (image.Format == EPF_Undefined) {
+            std::cout << std::format("GLASS error: Unsupported KTX2 vkFormat {}.", vkFormat);
+            return false;
+        }
+
+        if (!isLevelInFile(file, KTX2_HEADER_SIZE, levelCount * KTX2_LEVEL_INDEX_ENTRY_SIZE)) {
+            return false;
+        }
+
+        const uint32_t levels = std::min(levelCount, getMipLevelCount(image.Width, image.Height));
+        for (uint32_t level = 0; level < levels; ++level) {
+            const uint8_t* entry = data + KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+            const uint64_t offset = readValue<uint64_t>(entry);
+            const uint64_t length = readValue<uint64_t>(entry + 8);
+
+            const int32_t levelWidth = std::max(image.Width >> level, 1);
+            const int32_t levelHeight = std::max(image.Height >> level, 1);
+            if (length < getImageSizeInBytes(image.Format, levelWidth, levelHeight) || !isLevelInFile(file, offset, length)) {
+                return false;
+            }
+
+            image.Levels.push_back(data + offset);
+        }
+
+        return true;
+    }
+
+    /**
+     * DDS
+     */
+    static constexpr uint32_t makeFourCC(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+    }
+
+    static constexpr uint64_t DDS_HEADER_SIZE = 4 + 124;
+    static constexpr uint64_t DDS_DX10_HEADER_SIZE = 20;
+    static constexpr uint32_t DDS_PIXEL_FORMAT_FOURCC = 0x4;
+    static constexpr uint32_t DDS_PIXEL_FORMAT_RGB = 0x40;
+    static constexpr uint32_t DDS_CAPS2_CUBEMAP = 0x200;
+    static constexpr uint32_t DDS_CAPS2_VOLUME = 0x200000;
+
+    static EPixelFormat fromDXGIFormat(uint32_t dxgiFormat) {
+        switch (dxgiFormat) {
+            case 28: // DXGI_FORMAT_R8G8B8A8_UNORM
+                return EPF_RGBA8;
+            case 29: // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+                return EPF_SRGBA8;
+            case 71: // DXGI_FORMAT_BC1_UNORM
+                return EPF_BC1;
+            case 77: // DXGI_FORMAT_BC3_UNORM
+                return EPF_BC3;
+            case 80: // DXGI_FORMAT_BC4_UNORM
+                return EPF_BC4;
+            case 83: // DXGI_FORMAT_BC5_UNORM
+                return EPF_BC5;
+            case 98: // DXGI_FORMAT_BC7_UNORM
+                return EPF_BC7;
+        }
+
+        return EPF_Undefined;
+    }
+
+    static EPixelFormat fromFourCC(uint32_t fourCC) {
+        switch (fourCC) {
+            case makeFourCC('D', 'X', 'T', '1'):
+                return EPF_BC1;
+            case makeFourCC('D', 'X', 'T', '5'):
+                return EPF_BC3;
+            case makeFourCC('A', 'T', 'I', '1'):
+            case makeFourCC('B', 'C', '4', 'U'):
+                return EPF_BC4;
+            case makeFourCC('A', 'T', 'I', '2'):
+            case makeFourCC('B', 'C', '5', 'U'):
+                return EPF_BC5;
+        }
+
+        return EPF_Undefined;
+    }
+
+    static bool parseDDS(const io::MappedFile& file, LoadedImage& image) {
+        const uint8_t* data = file.getData();
+        if (file.getSize() < DDS_HEADER_SIZE) {
+            return false;
+        }
+
+        const uint32_t height = readValue<uint32_t>(data + 12);
+        const uint32_t width = readValue<uint32_t>(data + 16);
+        const uint32_t levelCount = std::max(readValue<uint32_t>(data + 28), 1u);
+        const uint32_t pixelFormatFlags = readValue<uint32_t>(data + 80);
+        const uint32_t fourCC = readValue<uint32_t>(data + 84);
+        const uint32_t bitCount = readValue<uint32_t>(data + 88);
+        const uint32_t redMask = readValue<uint32_t>(data + 92);
+        const uint32_t caps2 = readValue<uint32_t>(data + 112);
+
+        if (caps2 & (DDS_CAPS2_CUBEMAP | DDS_CAPS2_VOLUME)) {
+            std::cout << std::format("GLASS error: Cube map and volume DDS textures are not supported.");
+            return false;
+        }
+
+        uint64_t dataOffset = DDS_HEADER_SIZE;
+        if ((pixelFormatFlags & DDS_PIXEL_FORMAT_FOURCC) && fourCC == makeFourCC('D', 'X', '1', '0')) {
+            if (file.getSize() < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE) {
+                return false;
+            }
+
+            const uint32_t arraySize = readValue<uint32_t>(data + DDS_HEADER_SIZE + 12);
+            if (arraySize > 1) {
+                std::cout << std::format("GLASS error: DDS texture arrays are not supported.");
+                return false;
+            }
+
+            image.Format = fromDXGIFormat(readValue<uint32_t>(data + DDS_HEADER_SIZE));
+            dataOffset += DDS_DX10_HEADER_SIZE;
+        } else if (pixelFormatFlags & DDS_PIXEL_FORMAT_FOURCC) {
+            image.Format = fromFourCC(fourCC);
+        } else if ((pixelFormatFlags & DDS_PIXEL_FORMAT_RGB) && bitCount == 32 && redMask == 0x000000FF) {
+            image.Format = EPF_RGBA8;
+        }
+
+        if (image.Format == EPF_Undefined) {
+            std::cout << std::format("GLASS error: Unsupported DDS pixel format.");
+            return false;
+        }
+
+        image.Width = static_cast<int32_t>(width);
+        image.Height = static_cast<int32_t>(height);
+
+        // Levels are stored back to back, finest first
+        const uint32_t levels = std::min(levelCount, getMipLevelCount(image.Width, image.Height));
+        for (uint32_t level = 0; level < levels; ++level) {
+            const int32_t levelWidth = std::max(image.Width >> level, 1);
+            const int32_t levelHeight = std::max(image.Height >> level, 1);
+            const uint64_t length = getImageSizeInBytes(image.Format, levelWidth, levelHeight);
+            if (!isLevelInFile(file, dataOffset, length)) {
+                return false;
+            }
+
+            image.Levels.push_back(data + dataOffset);
+            dataOffset += length;
+        }
+
+        return true;
+    }
+
+    ResourceID loadTextureFile(const char* path, const SamplerSpec& sampler) {
+        const io::MappedFile file{ path };
+        if (!file.isOpen()) {
+            std::cout << std::format("GLASS error: Failed to open texture file: {}", path);
+            return ResourceID::Null;
+        }
+
+        LoadedImage image{};
+        bool parsed = false;
+        if (file.getSize() >= sizeof(KTX2_IDENTIFIER) && std::memcmp(file.getData(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0) {
+            parsed = parseKTX2(file, image);
+        } else if (file.getSize() >= 4 && readValue<uint32_t>(file.getData()) == makeFourCC('D', 'D', 'S', ' ')) {
+            parsed = parseDDS(file, image);
+        }
+
+        if (!parsed || image.Width <= 0 || image.Height <= 0) {
+            std::cout << std::format("GLASS error: Failed to load texture file: {}", path);
+            return ResourceID::Null;
+        }
+
+        // Levels are uploaded straight from the mapping, which is released once GL has copied them.
+        TextureSpec spec{};
+        spec.Type = ETT_Texture2D;
+        spec.Format = image.Format;
+        spec.Width = image.Width;
+        spec.Height = image.Height;
+        spec.Sampler = sampler;
+        spec.MipData = image.Levels.data();
+        spec.MipLevels = static_cast<uint32_t>(image.Levels.size());
+        return createTexture(spec);
+    }
+} // namespace glass::gfx
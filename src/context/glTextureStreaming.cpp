@@ -0,0 +1,161 @@
+#include "glass/glass.h"
+#include "glTexture.h"
+#include "glInternal.h"
+#include "glSampler.h"
+#include "cassert"
+#include "algorithm"
+#include "unordered_map"
+
+namespace glass::gfx {
+    struct StreamingTexture {
+        ResourceID Texture{};
+        int32_t Width{};
+        int32_t Height{};
+        uint32_t MipLevels{};
+        uint32_t RequestedMip{};
+        uint32_t ResidentMip{};
+        const void* const* MipData{};
+    };
+
+    // Keyed by the GL texture id. Fully resident textures stay registered so their requested mip can be changed.
+    static std::unordered_map<uint32_t, StreamingTexture> GStreamingTextures{};
+
+    static StreamingTexture* findStreamingTexture(ResourceID texture) {
+        const auto it = GStreamingTextures.find(getTextureID(texture));
+        return it != GStreamingTextures.end() ? &it->second : nullptr;
+    }
+
+    static uint64_t getMipSizeInBytes(const StreamingTexture& texture, uint32_t mipLevel) {
+        const int32_t width = std::max(texture.Width >> mipLevel, 1);
+        const int32_t height = std::max(texture.Height >> mipLevel, 1);
+        return getImageSizeInBytes(getTexturePixelFormat(texture.Texture), width, height);
+    }
+
+    static bool needsUpload(const StreamingTexture& texture) {
+        return texture.ResidentMip > texture.RequestedMip;
+    }
+
+    // Sampling never goes finer than what is both resident and requested. MIN_LOD is relative to the base level, so it is left to the sampler spec.
+    static void applyResidency(const StreamingTexture& texture) {
+        const uint32_t baseLevel = std::max(texture.ResidentMip, texture.RequestedMip);
+
+        invalidateActiveTextureUnit();
+        GLCALL(glBindTexture(GL_TEXTURE_2D, getTextureID(texture.Texture)));
+        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(baseLevel)));
+        GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
+    }
+
+    static void uploadNextMip(StreamingTexture& texture, bool async) {
+        const uint32_t mipLevel = texture.ResidentMip - 1;
+        const int32_t width = std::max(texture.Width >> mipLevel, 1);
+        const int32_t height = std::max(texture.Height >> mipLevel, 1);
+
+        writeTextureData(texture.Texture, mipLevel, 0, 0, 0, width, height, 1, texture.MipData[mipLevel], async);
+        texture.ResidentMip = mipLevel;
+    }
+
+    ResourceID createStreamingTexture(const StreamingTextureSpec& spec) {
+        assert(spec.MipData && "Streaming textures need the pixels of every mip level");
+        assert(spec.Format != EPF_DepthStencil && spec.Format != EPF_Undefined);
+
+        const uint32_t fullChain = getMipLevelCount(spec.Width, spec.Height);
+        const uint32_t mipLevels = spec.MipLevels == 0 ? fullChain : std::min(spec.MipLevels, fullChain);
+
+        TextureHandle outHandle{ ResourceID::Null };
+        outHandle.Id = 0;
+        outHandle.Type = ETT_Texture2D;
+        outHandle.Format = spec.Format;
+
+        invalidateActiveTextureUnit();
+        GLCALL(glGenTextures(1, &outHandle.TextureID));
+        GLCALL(glBindTexture(GL_TEXTURE_2D, outHandle.TextureID));
+        GLCALL(glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(mipLevels), toGLInternalFormat(spec.Format), spec.Width, spec.Height));
+        applySamplerSpec(
+            spec.Sampler,
+            [](GLenum parameter, GLint value) { GLCALL(glTexParameteri(GL_TEXTURE_2D, parameter, value)); },
+            [](GLenum parameter, GLfloat value) { GLCALL(glTexParameterf(GL_TEXTURE_2D, parameter, value)); });
+        GLCALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipLevels - 1)));
+        GLCALL(glBindTexture(GL_TEXTURE_2D, 0));
+
+        const ResourceID texture = static_cast<ResourceID>(outHandle.Id);
+        StreamingTexture& streaming = GStreamingTextures[outHandle.TextureID];
+        streaming = { texture, spec.Width, spec.Height, mipLevels, 0, mipLevels, spec.MipData };
+
+        // The coarsest levels are small, so they are uploaded directly to make the texture usable immediately.
+        uint64_t uploaded = 0;
+        while (needsUpload(streaming)) {
+            const uint64_t size = getMipSizeInBytes(streaming, streaming.ResidentMip - 1);
+            if (uploaded != 0 && uploaded + size > spec.InitialUploadBytes) {
+                break;
+            }
+
+            uploadNextMip(streaming, false);
+            uploaded += size;
+        }
+
+        applyResidency(streaming);
+        return texture;
+    }
+
+    uint64_t updateTextureStreaming(uint64_t byteBudget) {
+        uint64_t uploaded = 0;
+
+        // One level per texture per pass, so every texture sharpens at the same pace.
+        bool progressed = true;
+        while (progressed) {
+            progressed = false;
+
+            for (auto& [id, texture] : GStreamingTextures) {
+                if (!needsUpload(texture)) {
+                    continue;
+                }
+
+                const uint64_t size = getMipSizeInBytes(texture, texture.ResidentMip - 1);
+                if (uploaded != 0 && uploaded + size > byteBudget) {
+                    continue;
+                }
+
+                uploadNextMip(texture, true);
+                applyResidency(texture);
+                uploaded += size;
+                progressed = true;
+            }
+        }
+
+        return uploaded;
+    }
+
+    void setTextureRequestedMip(ResourceID texture, uint32_t mipLevel) {
+        StreamingTexture* streaming = findStreamingTexture(texture);
+        assert(streaming && "Texture was not created with createStreamingTexture");
+
+        mipLevel = std::min(mipLevel, streaming->MipLevels - 1);
+        if (streaming->RequestedMip != mipLevel) {
+            streaming->RequestedMip = mipLevel;
+            applyResidency(*streaming);
+        }
+    }
+
+    uint32_t getTextureRequestedMip(ResourceID texture) {
+        const StreamingTexture* streaming = findStreamingTexture(texture);
+        return streaming ? streaming->RequestedMip : 0;
+    }
+
+    uint32_t getTextureResidentMip(ResourceID texture) {
+        const StreamingTexture* streaming = findStreamingTexture(texture);
+        return streaming ? streaming->ResidentMip : 0;
+    }
+
+    bool isTextureStreamingComplete(ResourceID texture) {
+        const StreamingTexture* streaming = findStreamingTexture(texture);
+        return !streaming || !needsUpload(*streaming);
+    }
+
+    void forgetStreamingTexture(uint32_t textureID) {
+        GStreamingTextures.erase(textureID);
+    }
+
+    void freeTextureStreaming() {
+        GStreamingTextures.clear();
+    }
+} // namespace glass::gfx
@@ -0,0 +1,75 @@
+#include "cpuFeatures.h"
+
+#ifdef GLASS_ARCH_X86
+    #ifdef _MSC_VER
+        #include "intrin.h"
+    #else
+        #include "cpuid.h"
+    #endif
+#endif
+
+namespace glass::cpu {
+#ifdef GLASS_ARCH_X86
+    static void cpuid(uint32_t leaf, uint32_t subLeaf, uint32_t (&regs)[4]) {
+    #ifdef _MSC_VER
+        int values[4]{};
+        __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subLeaf));
+        for (int i = 0; i < 4; ++i) {
+            regs[i] = static_cast<uint32_t>(values[i]);
+        }
+    #else
+        __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+    }
+
+    static uint64_t xgetbv() {
+    #ifdef _MSC_VER
+        return _xgetbv(0);
+    #else
+        uint32_t eax{}, edx{};
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+    #endif
+    }
+
+    static CpuFeatures detectCpuFeatures() {
+        CpuFeatures features{};
+
+        uint32_t regs[4]{};
+        cpuid(0, 0, regs);
+        const uint32_t maxLeaf = regs[0];
+        if (maxLeaf < 1) {
+            return features;
+        }
+
+        cpuid(1, 0, regs);
+        features.SSE41 = (regs[2] >> 19) & 1;
+        const bool fma = (regs[2] >> 12) & 1;
+
+        // AVX state has to be enabled by the OS as well (OSXSAVE + XCR0)
+        const bool osxsave = (regs[2] >> 27) & 1;
+        if (!osxsave || maxLeaf < 7) {
+            return features;
+        }
+
+        const uint64_t xcr0 = xgetbv();
+        const bool osSupportsAVX = (xcr0 & 0x6) == 0x6;
+        const bool osSupportsAVX512 = (xcr0 & 0xE6) == 0xE6;
+
+        cpuid(7, 0, regs);
+        features.AVX2 = osSupportsAVX && ((regs[1] >> 5) & 1);
+        features.FMA = osSupportsAVX && fma;
+        features.AVX512F = osSupportsAVX512 && ((regs[1] >> 16) & 1);
+        return features;
+    }
+#else
+    static CpuFeatures detectCpuFeatures() {
+        return {};
+    }
+#endif
+
+    const CpuFeatures& getCpuFeatures() {
+        static const CpuFeatures features = detectCpuFeatures();
+        return features;
+    }
+} // namespace glass::cpu
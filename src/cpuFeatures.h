@@ -0,0 +1,22 @@
+#pragma once
+
+#include "cstdint"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define GLASS_ARCH_X86 1
+#endif
+
+namespace glass::cpu {
+    /** Instruction sets that are supported by both the CPU and the OS. */
+    struct CpuFeatures {
+        bool SSE41 : 1 = false;
+        bool AVX2 : 1 = false;
+
+        /** AVX2 kernels are built with FMA enabled (-mfma, /arch:AVX2), so they need both bits */
+        bool FMA : 1 = false;
+        bool AVX512F : 1 = false;
+    };
+
+    /** Detected once on first call. */
+    const CpuFeatures& getCpuFeatures();
+} // namespace glass::cpu
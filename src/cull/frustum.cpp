@@ -0,0 +1,25 @@
+#include "glass/glass.h"
+
+namespace glass::cull {
+    static glm::vec4 normalizePlane(const glm::vec4& plane) {
+        const float length = glm::length(glm::vec3(plane));
+        return length > 0.0f ? plane / length : plane;
+    }
+
+    Frustum extractFrustum(const glm::mat4& viewProjection) {
+        // Gribb-Hartmann plane extraction. glm matrices are column major, so rows are gathered manually.
+        const glm::vec4 row0{ viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+        const glm::vec4 row1{ viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+        const glm::vec4 row2{ viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+        const glm::vec4 row3{ viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+        Frustum frustum{};
+        frustum.Planes[0] = normalizePlane(row3 + row0); // Left
+        frustum.Planes[1] = normalizePlane(row3 - row0); // Right
+        frustum.Planes[2] = normalizePlane(row3 + row1); // Bottom
+        frustum.Planes[3] = normalizePlane(row3 - row1); // Top
+        frustum.Planes[4] = normalizePlane(row3 + row2); // Near
+        frustum.Planes[5] = normalizePlane(row3 - row2); // Far
+        return frustum;
+    }
+} // namespace glass::cull
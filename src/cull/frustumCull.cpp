@@ -0,0 +1,122 @@
+#include "frustumCullKernels.h"
+
+#include "cassert"
+
+namespace glass::cull {
+    void cullSpheresScalar(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t first, size_t count, uint64_t* outVisibility) {
+        assert(first % CULL_BLOCK_SIZE == 0);
+        for (size_t word = first / CULL_BLOCK_SIZE; word < getVisibilityMaskWordCount(first + count); ++word) {
+            outVisibility[word] = 0;
+        }
+
+        for (size_t i = first; i < first + count; ++i) {
+            const glm::vec3 center{ spheres.CenterX[i], spheres.CenterY[i], spheres.CenterZ[i] };
+            const float radius = spheres.Radius[i];
+
+            bool visible = true;
+            for (const glm::vec4& plane : frustum.Planes) {
+                visible &= glm::dot(glm::vec3(plane), center) + plane.w >= -radius;
+            }
+
+            outVisibility[i / CULL_BLOCK_SIZE] |= static_cast<uint64_t>(visible) << (i % CULL_BLOCK_SIZE);
+        }
+    }
+
+    void cullBoxesScalar(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t first, size_t count, uint64_t* outVisibility) {
+        assert(first % CULL_BLOCK_SIZE == 0);
+        for (size_t word = first / CULL_BLOCK_SIZE; word < getVisibilityMaskWordCount(first + count); ++word) {
+            outVisibility[word] = 0;
+        }
+
+        for (size_t i = first; i < first + count; ++i) {
+            bool visible = true;
+            for (const glm::vec4& plane : frustum.Planes) {
+                // Test the box corner that lies furthest along the plane normal
+                const glm::vec3 corner{
+                    plane.x >= 0.0f ? boxes.MaxX[i] : boxes.MinX[i],
+                    plane.y >= 0.0f ? boxes.MaxY[i] : boxes.MinY[i],
+                    plane.z >= 0.0f ? boxes.MaxZ[i] : boxes.MinZ[i],
+                };
+                visible &= glm::dot(glm::vec3(plane), corner) + plane.w >= 0.0f;
+            }
+
+            outVisibility[i / CULL_BLOCK_SIZE] |= static_cast<uint64_t>(visible) << (i % CULL_BLOCK_SIZE);
+        }
+    }
+
+    using PFN_CullSpheres = void (*)(const Frustum&, const BoundingSpheresSoA&, size_t, uint64_t*);
+    using PFN_CullBoxes = void (*)(const Frustum&, const BoundingBoxesSoA&, size_t, uint64_t*);
+
+    struct CullKernels {
+        ECullKernel Kernel{ ECK_Scalar };
+        PFN_CullSpheres CullSpheres{};
+        PFN_CullBoxes CullBoxes{};
+    };
+
+    static CullKernels selectCullKernels(ECullKernel requested) {
+#ifdef GLASS_ARCH_X86
+        const cpu::CpuFeatures& features = cpu::getCpuFeatures();
+        if (requested == ECK_Auto) {
+            requested = ECK_AVX512;
+        }
+
+        if (requested >= ECK_AVX512 && features.AVX512F) {
+            return { ECK_AVX512, cullSpheresAVX512, cullBoxesAVX512 };
+        }
+
+        if (requested >= ECK_AVX2 && features.AVX2 && features.FMA) {
+            return { ECK_AVX2, cullSpheresAVX2, cullBoxesAVX2 };
+        }
+
+        if (requested >= ECK_SSE41 && features.SSE41) {
+            return { ECK_SSE41, cullSpheresSSE41, cullBoxesSSE41 };
+        }
+#endif
+        return { ECK_Scalar, nullptr, nullptr };
+    }
+
+    static CullKernels GCullKernels = selectCullKernels(ECK_Auto);
+
+    void setCullKernel(ECullKernel kernel) {
+        GCullKernels = selectCullKernels(kernel);
+    }
+
+    ECullKernel getCullKernel() {
+        return GCullKernels.Kernel;
+    }
+
+    void frustumCull(const glm::mat4& viewProjection, const BoundingSpheresSoA& spheres, std::span<uint64_t> outVisibility) {
+        const size_t count = spheres.CenterX.size();
+        assert(spheres.CenterY.size() == count && spheres.CenterZ.size() == count && spheres.Radius.size() == count);
+        assert(outVisibility.size() >= getVisibilityMaskWordCount(count));
+
+        const Frustum frustum = extractFrustum(viewProjection);
+        const size_t blockCount = GCullKernels.CullSpheres ? count / CULL_BLOCK_SIZE : 0;
+        if (blockCount > 0) {
+            GCullKernels.CullSpheres(frustum, spheres, blockCount, outVisibility.data());
+        }
+
+        const size_t first = blockCount * CULL_BLOCK_SIZE;
+        if (first < count) {
+            cullSpheresScalar(frustum, spheres, first, count - first, outVisibility.data());
+        }
+    }
+
+    void frustumCull(const glm::mat4& viewProjection, const BoundingBoxesSoA& boxes, std::span<uint64_t> outVisibility) {
+        const size_t count = boxes.MinX.size();
+        assert(boxes.MinY.size() == count && boxes.MinZ.size() == count);
+        assert(boxes.MaxX.size() == count && boxes.MaxY.size() == count && boxes.MaxZ.size() == count);
+        assert(outVisibility.size() >= getVisibilityMaskWordCount(count));
+
+        const Frustum frustum = extractFrustum(viewProjection);
+        const size_t blockCount = GCullKernels.CullBoxes ? count / CULL_BLOCK_SIZE : 0;
+        if (blockCount > 0) {
+            GCullKernels.CullBoxes(frustum, boxes, blockCount, outVisibility.data());
+        }
+
+        const size_t first = blockCount * CULL_BLOCK_SIZE;
+        if (first < count) {
+            cullBoxesScalar(frustum, boxes, first, count - first, outVisibility.data());
+        }
+    }
+} // namespace glass::cull
@@ -0,0 +1,93 @@
+#include "frustumCullKernels.h"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::cull {
+    static constexpr uint32_t LANES = 8;
+
+    void cullSpheresAVX2(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility) {
+        __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            planeX[plane] = _mm256_set1_ps(frustum.Planes[plane].x);
+            planeY[plane] = _mm256_set1_ps(frustum.Planes[plane].y);
+            planeZ[plane] = _mm256_set1_ps(frustum.Planes[plane].z);
+            planeW[plane] = _mm256_set1_ps(frustum.Planes[plane].w);
+        }
+
+        const float* centerX = spheres.CenterX.data();
+        const float* centerY = spheres.CenterY.data();
+        const float* centerZ = spheres.CenterZ.data();
+        const float* radius = spheres.Radius.data();
+        const __m256 allSet = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m256 x = _mm256_loadu_ps(centerX + index);
+                const __m256 y = _mm256_loadu_ps(centerY + index);
+                const __m256 z = _mm256_loadu_ps(centerZ + index);
+                const __m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius + index));
+
+                __m256 visible = allSet;
+                for (int plane = 0; plane < 6; ++plane) {
+                    __m256 distance = _mm256_add_ps(_mm256_mul_ps(x, planeX[plane]), planeW[plane]);
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(y, planeY[plane]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(z, planeZ[plane]));
+                    visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+                }
+
+                word |= static_cast<uint64_t>(_mm256_movemask_ps(visible)) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+
+    void cullBoxesAVX2(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility) {
+        __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+        __m256 selectX[6], selectY[6], selectZ[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            const glm::vec4& p = frustum.Planes[plane];
+            planeX[plane] = _mm256_set1_ps(p.x);
+            planeY[plane] = _mm256_set1_ps(p.y);
+            planeZ[plane] = _mm256_set1_ps(p.z);
+            planeW[plane] = _mm256_set1_ps(p.w);
+            selectX[plane] = _mm256_castsi256_ps(_mm256_set1_epi32(p.x >= 0.0f ? -1 : 0));
+            selectY[plane] = _mm256_castsi256_ps(_mm256_set1_epi32(p.y >= 0.0f ? -1 : 0));
+            selectZ[plane] = _mm256_castsi256_ps(_mm256_set1_epi32(p.z >= 0.0f ? -1 : 0));
+        }
+
+        const __m256 allSet = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m256 minX = _mm256_loadu_ps(boxes.MinX.data() + index);
+                const __m256 minY = _mm256_loadu_ps(boxes.MinY.data() + index);
+                const __m256 minZ = _mm256_loadu_ps(boxes.MinZ.data() + index);
+                const __m256 maxX = _mm256_loadu_ps(boxes.MaxX.data() + index);
+                const __m256 maxY = _mm256_loadu_ps(boxes.MaxY.data() + index);
+                const __m256 maxZ = _mm256_loadu_ps(boxes.MaxZ.data() + index);
+
+                __m256 visible = allSet;
+                for (int plane = 0; plane < 6; ++plane) {
+                    const __m256 x = _mm256_blendv_ps(minX, maxX, selectX[plane]);
+                    const __m256 y = _mm256_blendv_ps(minY, maxY, selectY[plane]);
+                    const __m256 z = _mm256_blendv_ps(minZ, maxZ, selectZ[plane]);
+
+                    __m256 distance = _mm256_add_ps(_mm256_mul_ps(x, planeX[plane]), planeW[plane]);
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(y, planeY[plane]));
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(z, planeZ[plane]));
+                    visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+                }
+
+                word |= static_cast<uint64_t>(_mm256_movemask_ps(visible)) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+} // namespace glass::cull
+#endif
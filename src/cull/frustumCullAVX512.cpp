@@ -0,0 +1,91 @@
+#include "frustumCullKernels.h"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::cull {
+    static constexpr uint32_t LANES = 16;
+
+    void cullSpheresAVX512(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility) {
+        __m512 planeX[6], planeY[6], planeZ[6], planeW[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            planeX[plane] = _mm512_set1_ps(frustum.Planes[plane].x);
+            planeY[plane] = _mm512_set1_ps(frustum.Planes[plane].y);
+            planeZ[plane] = _mm512_set1_ps(frustum.Planes[plane].z);
+            planeW[plane] = _mm512_set1_ps(frustum.Planes[plane].w);
+        }
+
+        const float* centerX = spheres.CenterX.data();
+        const float* centerY = spheres.CenterY.data();
+        const float* centerZ = spheres.CenterZ.data();
+        const float* radius = spheres.Radius.data();
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m512 x = _mm512_loadu_ps(centerX + index);
+                const __m512 y = _mm512_loadu_ps(centerY + index);
+                const __m512 z = _mm512_loadu_ps(centerZ + index);
+                const __m512 negRadius = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_loadu_ps(radius + index));
+
+                __mmask16 visible = 0xFFFF;
+                for (int plane = 0; plane < 6; ++plane) {
+                    __m512 distance = _mm512_fmadd_ps(x, planeX[plane], planeW[plane]);
+                    distance = _mm512_fmadd_ps(y, planeY[plane], distance);
+                    distance = _mm512_fmadd_ps(z, planeZ[plane], distance);
+                    visible = _mm512_mask_cmp_ps_mask(visible, distance, negRadius, _CMP_GE_OQ);
+                }
+
+                word |= static_cast<uint64_t>(visible) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+
+    void cullBoxesAVX512(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility) {
+        __m512 planeX[6], planeY[6], planeZ[6], planeW[6];
+        __mmask16 selectX[6], selectY[6], selectZ[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            const glm::vec4& p = frustum.Planes[plane];
+            planeX[plane] = _mm512_set1_ps(p.x);
+            planeY[plane] = _mm512_set1_ps(p.y);
+            planeZ[plane] = _mm512_set1_ps(p.z);
+            planeW[plane] = _mm512_set1_ps(p.w);
+            selectX[plane] = p.x >= 0.0f ? 0xFFFF : 0;
+            selectY[plane] = p.y >= 0.0f ? 0xFFFF : 0;
+            selectZ[plane] = p.z >= 0.0f ? 0xFFFF : 0;
+        }
+
+        const __m512 zero = _mm512_setzero_ps();
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m512 minX = _mm512_loadu_ps(boxes.MinX.data() + index);
+                const __m512 minY = _mm512_loadu_ps(boxes.MinY.data() + index);
+                const __m512 minZ = _mm512_loadu_ps(boxes.MinZ.data() + index);
+                const __m512 maxX = _mm512_loadu_ps(boxes.MaxX.data() + index);
+                const __m512 maxY = _mm512_loadu_ps(boxes.MaxY.data() + index);
+                const __m512 maxZ = _mm512_loadu_ps(boxes.MaxZ.data() + index);
+
+                __mmask16 visible = 0xFFFF;
+                for (int plane = 0; plane < 6; ++plane) {
+                    const __m512 x = _mm512_mask_blend_ps(selectX[plane], minX, maxX);
+                    const __m512 y = _mm512_mask_blend_ps(selectY[plane], minY, maxY);
+                    const __m512 z = _mm512_mask_blend_ps(selectZ[plane], minZ, maxZ);
+
+                    __m512 distance = _mm512_fmadd_ps(x, planeX[plane], planeW[plane]);
+                    distance = _mm512_fmadd_ps(y, planeY[plane], distance);
+                    distance = _mm512_fmadd_ps(z, planeZ[plane], distance);
+                    visible = _mm512_mask_cmp_ps_mask(visible, distance, zero, _CMP_GE_OQ);
+                }
+
+                word |= static_cast<uint64_t>(visible) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+} // namespace glass::cull
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "cpuFeatures.h"
+
+namespace glass::cull {
+    /** Bounding volumes are processed in blocks that fill exactly one visibility word. */
+    static constexpr size_t CULL_BLOCK_SIZE = 64;
+
+    /**
+     * Scalar kernels. Test count volumes starting at first (must be a multiple of CULL_BLOCK_SIZE)
+     * and overwrite the corresponding visibility words.
+     */
+    void cullSpheresScalar(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t first, size_t count, uint64_t* outVisibility);
+    void cullBoxesScalar(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t first, size_t count, uint64_t* outVisibility);
+
+#ifdef GLASS_ARCH_X86
+    /** Vectorized kernels. Test blockCount full blocks starting at the first volume. */
+    void cullSpheresSSE41(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility);
+    void cullBoxesSSE41(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility);
+
+    void cullSpheresAVX2(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility);
+    void cullBoxesAVX2(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility);
+
+    void cullSpheresAVX512(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility);
+    void cullBoxesAVX512(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility);
+#endif
+} // namespace glass::cull
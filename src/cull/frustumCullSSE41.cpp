@@ -0,0 +1,94 @@
+#include "frustumCullKernels.h"
+
+#ifdef GLASS_ARCH_X86
+    #include "smmintrin.h"
+
+namespace glass::cull {
+    static constexpr uint32_t LANES = 4;
+
+    void cullSpheresSSE41(const Frustum& frustum, const BoundingSpheresSoA& spheres, size_t blockCount, uint64_t* outVisibility) {
+        __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            planeX[plane] = _mm_set1_ps(frustum.Planes[plane].x);
+            planeY[plane] = _mm_set1_ps(frustum.Planes[plane].y);
+            planeZ[plane] = _mm_set1_ps(frustum.Planes[plane].z);
+            planeW[plane] = _mm_set1_ps(frustum.Planes[plane].w);
+        }
+
+        const float* centerX = spheres.CenterX.data();
+        const float* centerY = spheres.CenterY.data();
+        const float* centerZ = spheres.CenterZ.data();
+        const float* radius = spheres.Radius.data();
+        const __m128 allSet = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m128 x = _mm_loadu_ps(centerX + index);
+                const __m128 y = _mm_loadu_ps(centerY + index);
+                const __m128 z = _mm_loadu_ps(centerZ + index);
+                const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + index));
+
+                __m128 visible = allSet;
+                for (int plane = 0; plane < 6; ++plane) {
+                    __m128 distance = _mm_add_ps(_mm_mul_ps(x, planeX[plane]), planeW[plane]);
+                    distance = _mm_add_ps(distance, _mm_mul_ps(y, planeY[plane]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(z, planeZ[plane]));
+                    visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negRadius));
+                }
+
+                word |= static_cast<uint64_t>(_mm_movemask_ps(visible)) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+
+    void cullBoxesSSE41(const Frustum& frustum, const BoundingBoxesSoA& boxes, size_t blockCount, uint64_t* outVisibility) {
+        // Per plane masks selecting the max (positive normal component) or min box corner
+        __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+        __m128 selectX[6], selectY[6], selectZ[6];
+        for (int plane = 0; plane < 6; ++plane) {
+            const glm::vec4& p = frustum.Planes[plane];
+            planeX[plane] = _mm_set1_ps(p.x);
+            planeY[plane] = _mm_set1_ps(p.y);
+            planeZ[plane] = _mm_set1_ps(p.z);
+            planeW[plane] = _mm_set1_ps(p.w);
+            selectX[plane] = _mm_castsi128_ps(_mm_set1_epi32(p.x >= 0.0f ? -1 : 0));
+            selectY[plane] = _mm_castsi128_ps(_mm_set1_epi32(p.y >= 0.0f ? -1 : 0));
+            selectZ[plane] = _mm_castsi128_ps(_mm_set1_epi32(p.z >= 0.0f ? -1 : 0));
+        }
+
+        const __m128 allSet = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        const __m128 zero = _mm_setzero_ps();
+
+        for (size_t block = 0; block < blockCount; ++block) {
+            uint64_t word = 0;
+            for (uint32_t lane = 0; lane < CULL_BLOCK_SIZE; lane += LANES) {
+                const size_t index = block * CULL_BLOCK_SIZE + lane;
+                const __m128 minX = _mm_loadu_ps(boxes.MinX.data() + index);
+                const __m128 minY = _mm_loadu_ps(boxes.MinY.data() + index);
+                const __m128 minZ = _mm_loadu_ps(boxes.MinZ.data() + index);
+                const __m128 maxX = _mm_loadu_ps(boxes.MaxX.data() + index);
+                const __m128 maxY = _mm_loadu_ps(boxes.MaxY.data() + index);
+                const __m128 maxZ = _mm_loadu_ps(boxes.MaxZ.data() + index);
+
+                __m128 visible = allSet;
+                for (int plane = 0; plane < 6; ++plane) {
+                    const __m128 x = _mm_blendv_ps(minX, maxX, selectX[plane]);
+                    const __m128 y = _mm_blendv_ps(minY, maxY, selectY[plane]);
+                    const __m128 z = _mm_blendv_ps(minZ, maxZ, selectZ[plane]);
+
+                    __m128 distance = _mm_add_ps(_mm_mul_ps(x, planeX[plane]), planeW[plane]);
+                    distance = _mm_add_ps(distance, _mm_mul_ps(y, planeY[plane]));
+                    distance = _mm_add_ps(distance, _mm_mul_ps(z, planeZ[plane]));
+                    visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, zero));
+                }
+
+                word |= static_cast<uint64_t>(_mm_movemask_ps(visible)) << lane;
+            }
+            outVisibility[block] = word;
+        }
+    }
+} // namespace glass::cull
+#endif
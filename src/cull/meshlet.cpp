@@ -0,0 +1,190 @@
+#include "glass/glass.h"
+
+#include "cassert"
+#include "cmath"
+
+namespace glass::cull {
+    static glm::vec3 getPosition(const MeshletBuildSpec& spec, uint32_t index) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(spec.Positions) + spec.PositionStrideInBytes * index;
+        const auto* position = reinterpret_cast<const float*>(bytes);
+        return { position[0], position[1], position[2] };
+    }
+
+    static MeshletBounds computeMeshletBounds(const MeshletBuildSpec& spec, const uint32_t* indices, uint32_t triangleCount) {
+        MeshletBounds bounds{};
+
+        // Bounding sphere around the AABB center. Not minimal, but cheap and stable.
+        glm::vec3 min{ getPosition(spec, indices[0]) };
+        glm::vec3 max{ min };
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            const glm::vec3 position = getPosition(spec, indices[i]);
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        bounds.Center = (min + max) * 0.5f;
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            bounds.Radius = std::max(bounds.Radius, glm::distance(bounds.Center, getPosition(spec, indices[i])));
+        }
+
+        // Normal cone
+        glm::vec3 normalSum{};
+        for (uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+            const glm::vec3 p0 = getPosition(spec, indices[triangle * 3 + 0]);
+            const glm::vec3 p1 = getPosition(spec, indices[triangle * 3 + 1]);
+            const glm::vec3 p2 = getPosition(spec, indices[triangle * 3 + 2]);
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            if (area > 0.0f) {
+                normalSum += normal / area;
+            }
+        }
+
+        const float axisLength = glm::length(normalSum);
+        if (axisLength <= 0.0f) {
+            return bounds;
+        }
+
+        const glm::vec3 axis = normalSum / axisLength;
+        float minDot = 1.0f;
+        float maxApexDistance = 0.0f;
+        for (uint32_t triangle = 0; triangle < triangleCount; ++triangle) {
+            const glm::vec3 p0 = getPosition(spec, indices[triangle * 3 + 0]);
+            const glm::vec3 p1 = getPosition(spec, indices[triangle * 3 + 1]);
+            const glm::vec3 p2 = getPosition(spec, indices[triangle * 3 + 2]);
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            if (area <= 0.0f) {
+                continue;
+            }
+
+            const glm::vec3 unitNormal = normal / area;
+            const float axisDot = glm::dot(axis, unitNormal);
+            minDot = std::min(minDot, axisDot);
+
+            // Move the apex back along the axis until every triangle plane is in front of it.
+            if (axisDot > 0.0f) {
+                maxApexDistance = std::max(maxApexDistance, glm::dot(bounds.Center - p0, unitNormal) / axisDot);
+            }
+        }
+
+        bounds.ConeAxis = axis;
+
+        // Cones wider than ~84 degrees are practically never back facing as a whole.
+        if (minDot <= 0.1f) {
+            bounds.ConeApex = bounds.Center;
+            bounds.ConeCutoff = 1.0f;
+            return bounds;
+        }
+
+        bounds.ConeApex = bounds.Center - axis * maxApexDistance;
+        bounds.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+        return bounds;
+    }
+
+    MeshletMesh buildMeshlets(const MeshletBuildSpec& spec) {
+        assert(spec.Positions && spec.Indices && "Meshlet build requires positions and indices");
+        assert(spec.IndexCount % 3 == 0 && "Meshlets can only be built from triangle lists");
+        assert(spec.MaxVertices >= 3 && spec.MaxTriangles >= 1);
+
+        MeshletMesh mesh{};
+        mesh.Indices.reserve(spec.IndexCount);
+
+        // Stores (meshlet index + 1) for every vertex that is already referenced by the current meshlet.
+        std::vector<uint32_t> vertexOwner(spec.VertexCount, 0);
+
+        Meshlet current{};
+        const auto finishMeshlet = [&]() {
+            if (current.TriangleCount == 0) {
+                return;
+            }
+
+            current.Bounds = computeMeshletBounds(spec, mesh.Indices.data() + current.FirstIndex, current.TriangleCount);
+            mesh.Meshlets.push_back(current);
+
+            current = {};
+            current.FirstIndex = static_cast<uint32_t>(mesh.Indices.size());
+        };
+
+        for (uint32_t index = 0; index < spec.IndexCount; index += 3) {
+            const uint32_t a = spec.Indices[index + 0];
+            const uint32_t b = spec.Indices[index + 1];
+            const uint32_t c = spec.Indices[index + 2];
+            assert(a < spec.VertexCount && b < spec.VertexCount && c < spec.VertexCount);
+
+            uint32_t owner = static_cast<uint32_t>(mesh.Meshlets.size()) + 1;
+            uint32_t newVertices = vertexOwner[a] != owner;
+            newVertices += b != a && vertexOwner[b] != owner;
+            newVertices += c != a && c != b && vertexOwner[c] != owner;
+
+            if (current.VertexCount + newVertices > spec.MaxVertices || current.TriangleCount + 1 > spec.MaxTriangles) {
+                finishMeshlet();
+                owner = static_cast<uint32_t>(mesh.Meshlets.size()) + 1;
+            }
+
+            for (uint32_t vertex : { a, b, c }) {
+                if (vertexOwner[vertex] != owner) {
+                    vertexOwner[vertex] = owner;
+                    current.VertexCount++;
+                }
+            }
+
+            mesh.Indices.push_back(a);
+            mesh.Indices.push_back(b);
+            mesh.Indices.push_back(c);
+            current.TriangleCount++;
+        }
+
+        finishMeshlet();
+        return mesh;
+    }
+
+    static bool isSphereVisible(const Frustum& frustum, const glm::vec3& center, float radius) {
+        for (const glm::vec4& plane : frustum.Planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool isConeBackFacing(const MeshletBounds& bounds, const glm::vec3& cameraPosition) {
+        if (bounds.ConeCutoff >= 1.0f) {
+            return false;
+        }
+
+        const glm::vec3 toApex = bounds.ConeApex - cameraPosition;
+        const float distance = glm::length(toApex);
+        return distance > 0.0f && glm::dot(toApex / distance, bounds.ConeAxis) >= bounds.ConeCutoff;
+    }
+
+    uint32_t cullMeshlets(const MeshletMesh& mesh, const Frustum& frustum, const glm::vec3& cameraPosition, std::vector<gfx::DrawElementsIndirectCommand>& outCommands, int32_t baseVertex, uint32_t baseInstance) {
+        uint32_t visibleCount = 0;
+        bool extendsPrevious = false;
+
+        for (const Meshlet& meshlet : mesh.Meshlets) {
+            const MeshletBounds& bounds = meshlet.Bounds;
+            if (!isSphereVisible(frustum, bounds.Center, bounds.Radius) || isConeBackFacing(bounds, cameraPosition)) {
+                extendsPrevious = false;
+                continue;
+            }
+
+            visibleCount++;
+            if (extendsPrevious) {
+                outCommands.back().Count += meshlet.TriangleCount * 3;
+                continue;
+            }
+
+            gfx::DrawElementsIndirectCommand command{};
+            command.Count = meshlet.TriangleCount * 3;
+            command.InstanceCount = 1;
+            command.FirstIndex = meshlet.FirstIndex;
+            command.BaseVertex = baseVertex;
+            command.BaseInstance = baseInstance;
+            outCommands.push_back(command);
+            extendsPrevious = true;
+        }
+
+        return visibleCount;
+    }
+} // namespace glass::cull
@@ -0,0 +1,234 @@
+#include "imageKernels.h"
+#include "parallel.h"
+#include "cassert"
+#include "algorithm"
+
+namespace glass::image {
+    void encodeBC1BlocksScalar(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out) {
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += 8) {
+            int32_t minColor[3] = { 255, 255, 255 };
+            int32_t maxColor[3] = { 0, 0, 0 };
+            for (uint32_t y = 0; y < 4; ++y) {
+                const uint8_t* row = pixels + y * rowPitch;
+                for (uint32_t x = 0; x < 4; ++x) {
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        minColor[c] = std::min<int32_t>(minColor[c], row[x * 4 + c]);
+                        maxColor[c] = std::max<int32_t>(maxColor[c], row[x * 4 + c]);
+                    }
+                }
+            }
+
+            const BC1Endpoints endpoints = computeBC1Endpoints(minColor, maxColor);
+
+            uint8_t steps[16]{};
+            for (uint32_t y = 0; y < 4; ++y) {
+                const uint8_t* row = pixels + y * rowPitch;
+                for (uint32_t x = 0; x < 4; ++x) {
+                    int32_t t = 0;
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        t += (row[x * 4 + c] - endpoints.Origin[c]) * endpoints.Axis[c];
+                    }
+                    steps[y * 4 + x] = static_cast<uint8_t>(quantizeBC1Projection(t, endpoints.AxisLengthSq));
+                }
+            }
+
+            writeBC1Block(endpoints, steps, out);
+        }
+    }
+
+    void encodeBC4BlocksScalar(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out) {
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += outStride) {
+            uint8_t values[16]{};
+            for (uint32_t y = 0; y < 4; ++y) {
+                for (uint32_t x = 0; x < 4; ++x) {
+                    values[y * 4 + x] = pixels[y * rowPitch + x * 4 + channel];
+                }
+            }
+
+            const uint8_t minValue = *std::min_element(values, values + 16);
+            const uint8_t maxValue = *std::max_element(values, values + 16);
+
+            uint8_t steps[16]{};
+            for (uint32_t i = 0; i < 16; ++i) {
+                steps[i] = static_cast<uint8_t>(quantizeBC4Value(maxValue, maxValue - minValue, values[i]));
+            }
+
+            writeBC4Block(maxValue, minValue, steps, out);
+        }
+    }
+
+    static uint32_t getBlockSize(gfx::EPixelFormat format) {
+        switch (format) {
+            case gfx::EPF_BC1:
+            case gfx::EPF_BC4:
+                return 8;
+            case gfx::EPF_BC5:
+                return 16;
+        }
+
+        assert(false && "Only BC1, BC4 and BC5 are supported by the runtime encoder");
+        return 0;
+    }
+
+    uint64_t getCompressedImageSize(gfx::EPixelFormat format, int32_t width, int32_t height) {
+        const uint64_t blocksX = (static_cast<uint64_t>(width) + 3) / 4;
+        const uint64_t blocksY = (static_cast<uint64_t>(height) + 3) / 4;
+        return blocksX * blocksY * getBlockSize(format);
+    }
+
+    static void encodeBlocks(const ImageKernels& kernels, gfx::EPixelFormat format, const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out) {
+        switch (format) {
+            case gfx::EPF_BC1:
+                kernels.EncodeBC1(pixels, rowPitch, blockCount, out);
+                break;
+            case gfx::EPF_BC4:
+                kernels.EncodeBC4(pixels, rowPitch, blockCount, 0, 8, out);
+                break;
+            case gfx::EPF_BC5:
+                kernels.EncodeBC4(pixels, rowPitch, blockCount, 0, 16, out);
+                kernels.EncodeBC4(pixels, rowPitch, blockCount, 1, 16, out + 8);
+                break;
+        }
+    }
+
+    // Rows of blocks per thread below which spawning threads costs more than it saves
+    static constexpr uint32_t MIN_BLOCK_ROWS_PER_THREAD = 16;
+
+    void compressImage(const ImageView& source, gfx::EPixelFormat format, std::span<uint8_t> out, uint32_t threadCount) {
+        assert(source.Pixels && source.Width > 0 && source.Height > 0);
+        assert(out.size() >= getCompressedImageSize(format, source.Width, source.Height));
+
+        const uint32_t rowPitch = source.RowPitch != 0 ? source.RowPitch : static_cast<uint32_t>(source.Width) * 4;
+        const uint32_t blockSize = getBlockSize(format);
+        const uint32_t blocksX = (static_cast<uint32_t>(source.Width) + 3) / 4;
+        const uint32_t blocksY = (static_cast<uint32_t>(source.Height) + 3) / 4;
+        const uint32_t fullBlocksX = static_cast<uint32_t>(source.Width) / 4;
+        const ImageKernels kernels = getImageKernels();
+
+        if (threadCount == 0) {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        threadCount = std::clamp(blocksY / MIN_BLOCK_ROWS_PER_THREAD, 1u, threadCount);
+
+        parallelFor(blocksY, threadCount, [&](size_t firstRow, size_t lastRow) {
+            for (size_t blockY = firstRow; blockY < lastRow; ++blockY) {
+                const uint32_t y = static_cast<uint32_t>(blockY) * 4;
+                uint8_t* outRow = out.data() + blockY * blocksX * blockSize;
+
+                uint32_t firstPadded = 0;
+                if (y + 4 <= static_cast<uint32_t>(source.Height)) {
+                    encodeBlocks(kernels, format, source.Pixels + static_cast<size_t>(y) * rowPitch, rowPitch, fullBlocksX, outRow);
+                    firstPadded = fullBlocksX;
+                }
+
+                // Blocks crossing the right or bottom edge are encoded from a copy that repeats the edge pixels
+                for (uint32_t blockX = firstPadded; blockX < blocksX; ++blockX) {
+                    uint8_t padded[64];
+                    for (uint32_t py = 0; py < 4; ++py) {
+                        const uint32_t sourceY = std::min(y + py, static_cast<uint32_t>(source.Height) - 1);
+                        for (uint32_t px = 0; px < 4; ++px) {
+                            const uint32_t sourceX = std::min(blockX * 4 + px, static_cast<uint32_t>(source.Width) - 1);
+                            std::copy_n(source.Pixels + static_cast<size_t>(sourceY) * rowPitch + sourceX * 4, 4, padded + py * 16 + px * 4);
+                        }
+                    }
+
+                    encodeBlocks(kernels, format, padded, 16, 1, outRow + blockX * blockSize);
+                }
+            }
+        });
+    }
+
+    static void decodeBC1Block(const uint8_t* block, uint8_t texels[16][4]) {
+        const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+        const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+        const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+
+        int32_t palette[4][4]{};
+        expandRGB565(color0, palette[0]);
+        expandRGB565(color1, palette[1]);
+        palette[0][3] = palette[1][3] = palette[2][3] = 255;
+        for (int32_t c = 0; c < 3; ++c) {
+            if (color0 > color1) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            } else {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            }
+        }
+        palette[3][3] = color0 > color1 ? 255 : 0;
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            const uint32_t index = (indices >> (i * 2)) & 3;
+            for (uint32_t c = 0; c < 4; ++c) {
+                texels[i][c] = static_cast<uint8_t>(palette[index][c]);
+            }
+        }
+    }
+
+    static void decodeBC4Block(const uint8_t* block, uint8_t values[16]) {
+        const int32_t value0 = block[0];
+        const int32_t value1 = block[1];
+
+        int32_t palette[8] = { value0, value1 };
+        if (value0 > value1) {
+            for (int32_t i = 1; i < 7; ++i) {
+                palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+            }
+        } else {
+            for (int32_t i = 1; i < 5; ++i) {
+                palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (uint32_t i = 0; i < 6; ++i) {
+            indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+        }
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            values[i] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+        }
+    }
+
+    void decompressImage(std::span<const uint8_t> blocks, gfx::EPixelFormat format, int32_t width, int32_t height, std::span<uint8_t> outPixels) {
+        assert(blocks.size() >= getCompressedImageSize(format, width, height));
+        assert(outPixels.size() >= static_cast<size_t>(width) * height * 4);
+
+        const uint32_t blockSize = getBlockSize(format);
+        const uint32_t blocksX = (static_cast<uint32_t>(width) + 3) / 4;
+        const uint32_t blocksY = (static_cast<uint32_t>(height) + 3) / 4;
+
+        for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+            for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+                const uint8_t* block = blocks.data() + (static_cast<size_t>(blockY) * blocksX + blockX) * blockSize;
+
+                uint8_t texels[16][4]{};
+                if (format == gfx::EPF_BC1) {
+                    decodeBC1Block(block, texels);
+                } else {
+                    uint8_t red[16]{};
+                    uint8_t green[16]{};
+                    decodeBC4Block(block, red);
+                    if (format == gfx::EPF_BC5) {
+                        decodeBC4Block(block + 8, green);
+                    }
+
+                    for (uint32_t i = 0; i < 16; ++i) {
+                        texels[i][0] = red[i];
+                        texels[i][1] = green[i];
+                        texels[i][3] = 255;
+                    }
+                }
+
+                for (uint32_t py = 0; py < 4 && blockY * 4 + py < static_cast<uint32_t>(height); ++py) {
+                    for (uint32_t px = 0; px < 4 && blockX * 4 + px < static_cast<uint32_t>(width); ++px) {
+                        uint8_t* pixel = outPixels.data() + ((static_cast<size_t>(blockY) * 4 + py) * width + blockX * 4 + px) * 4;
+                        std::copy_n(texels[py * 4 + px], 4, pixel);
+                    }
+                }
+            }
+        }
+    }
+} // namespace glass::image
@@ -0,0 +1,80 @@
+#include "bcEncodeX86.h"
+
+#ifdef GLASS_ARCH_X86
+
+namespace glass::image {
+    /** Pack 16 lanes of 16 bit steps back into 16 bytes in texel order */
+    static inline __m128i packSteps(__m256i steps) {
+        return _mm_packs_epi16(_mm256_castsi256_si128(steps), _mm256_extracti128_si256(steps, 1));
+    }
+
+    void encodeBC1BlocksAVX2(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i six = _mm256_set1_epi32(6);
+
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += 8) {
+            __m128i red, green, blue;
+            loadBlockPlanar(pixels, rowPitch, red, green, blue);
+
+            const int32_t minColor[3] = { horizontalMin(red), horizontalMin(green), horizontalMin(blue) };
+            const int32_t maxColor[3] = { horizontalMax(red), horizontalMax(green), horizontalMax(blue) };
+            const BC1Endpoints endpoints = computeBC1Endpoints(minColor, maxColor);
+
+            // All 16 texels as 16 bit offsets from the origin
+            const __m256i r = _mm256_sub_epi16(_mm256_cvtepu8_epi16(red), _mm256_set1_epi16(static_cast<int16_t>(endpoints.Origin[0])));
+            const __m256i g = _mm256_sub_epi16(_mm256_cvtepu8_epi16(green), _mm256_set1_epi16(static_cast<int16_t>(endpoints.Origin[1])));
+            const __m256i b = _mm256_sub_epi16(_mm256_cvtepu8_epi16(blue), _mm256_set1_epi16(static_cast<int16_t>(endpoints.Origin[2])));
+            const __m256i axisRedGreen = _mm256_set1_epi32(packFactors(endpoints.Axis[0], endpoints.Axis[1]));
+            const __m256i axisBlue = _mm256_set1_epi32(packFactors(endpoints.Axis[2], 0));
+
+            // scaled >= n * length <=> scaled > n * length - 1
+            const __m256i threshold1 = _mm256_set1_epi32(endpoints.AxisLengthSq - 1);
+            const __m256i threshold3 = _mm256_set1_epi32(endpoints.AxisLengthSq * 3 - 1);
+            const __m256i threshold5 = _mm256_set1_epi32(endpoints.AxisLengthSq * 5 - 1);
+
+            // Unpacking works per 128 bit lane: the low half holds texels 0-3 and 8-11, the high half 4-7 and 12-15.
+            // _mm256_packs_epi32 below undoes the interleave.
+            __m256i steps32[2];
+            for (int32_t half = 0; half < 2; ++half) {
+                const __m256i redGreen = half ? _mm256_unpackhi_epi16(r, g) : _mm256_unpacklo_epi16(r, g);
+                const __m256i blueZero = half ? _mm256_unpackhi_epi16(b, zero) : _mm256_unpacklo_epi16(b, zero);
+                const __m256i t = _mm256_add_epi32(_mm256_madd_epi16(redGreen, axisRedGreen), _mm256_madd_epi16(blueZero, axisBlue));
+                const __m256i scaled = _mm256_mullo_epi32(t, six);
+
+                __m256i step = _mm256_sub_epi32(zero, _mm256_cmpgt_epi32(scaled, threshold1));
+                step = _mm256_sub_epi32(step, _mm256_cmpgt_epi32(scaled, threshold3));
+                step = _mm256_sub_epi32(step, _mm256_cmpgt_epi32(scaled, threshold5));
+                steps32[half] = step;
+            }
+
+            alignas(16) uint8_t steps[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(steps), packSteps(_mm256_packs_epi32(steps32[0], steps32[1])));
+            writeBC1Block(endpoints, steps, out);
+        }
+    }
+
+    void encodeBC4BlocksAVX2(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out) {
+        const __m256i fourteen = _mm256_set1_epi16(14);
+
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += outStride) {
+            const __m128i values = loadBlockChannel(pixels, rowPitch, channel);
+            const uint8_t minValue = horizontalMin(values);
+            const uint8_t maxValue = horizontalMax(values);
+            const int32_t range = maxValue - minValue;
+
+            const __m256i v = _mm256_cvtepu8_epi16(values);
+            const __m256i scaled = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_set1_epi16(maxValue), v), fourteen);
+
+            __m256i step = _mm256_setzero_si256();
+            for (int32_t k = 1; k < 8; ++k) {
+                const __m256i threshold = _mm256_set1_epi16(static_cast<int16_t>((2 * k - 1) * range - 1));
+                step = _mm256_sub_epi16(step, _mm256_cmpgt_epi16(scaled, threshold));
+            }
+
+            alignas(16) uint8_t steps[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(steps), packSteps(step));
+            writeBC4Block(maxValue, minValue, steps, out);
+        }
+    }
+} // namespace glass::image
+#endif
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "cpuFeatures.h"
+
+namespace glass::image {
+    /**
+     * All kernels encode blockCount horizontally adjacent 4x4 blocks. pixels points to the top left pixel of the first block,
+     * rowPitch is the distance between pixel rows in bytes.
+     *
+     * Endpoints come from the (inset) bounding box of the block and every texel is assigned the palette entry nearest
+     * to its projection on the endpoint axis. The vectorized kernels only speed up the per-texel work and produce
+     * exactly the same blocks as the scalar ones.
+     */
+    void encodeBC1BlocksScalar(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out);
+
+    /** Encode one channel (0 = red) into 8 byte BC4 blocks written outStride bytes apart. BC5 is two interleaved BC4 passes. */
+    void encodeBC4BlocksScalar(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out);
+
+#ifdef GLASS_ARCH_X86
+    void encodeBC1BlocksSSE41(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out);
+    void encodeBC4BlocksSSE41(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out);
+
+    void encodeBC1BlocksAVX2(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out);
+    void encodeBC4BlocksAVX2(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out);
+#endif
+
+    /**
+     * Shared by all kernels
+     */
+    static constexpr uint16_t packRGB565(int32_t r, int32_t g, int32_t b) {
+        return static_cast<uint16_t>((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+    }
+
+    static constexpr void expandRGB565(uint16_t color, int32_t out[3]) {
+        const int32_t r = (color >> 11) & 31;
+        const int32_t g = (color >> 5) & 63;
+        const int32_t b = color & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+    }
+
+    /** Endpoints of a BC1 block and the axis the texels are projected on */
+    struct BC1Endpoints {
+        uint16_t Color0{};
+        uint16_t Color1{};
+
+        /** Expanded Color0, the origin of the projection */
+        int32_t Origin[3]{};
+
+        /** Expanded Color1 - Color0 */
+        int32_t Axis[3]{};
+
+        /** Squared length of Axis. 0 if both endpoints are the same color. */
+        int32_t AxisLengthSq{};
+    };
+
+    /** Inset the bounding box by 1/16 of its size on both ends to reduce the error of the interpolated colors. */
+    static constexpr BC1Endpoints computeBC1Endpoints(const int32_t minColor[3], const int32_t maxColor[3]) {
+        BC1Endpoints endpoints{};
+        int32_t high[3]{};
+        int32_t low[3]{};
+        for (int32_t c = 0; c < 3; ++c) {
+            const int32_t inset = (maxColor[c] - minColor[c]) >> 4;
+            high[c] = maxColor[c] - inset;
+            low[c] = minColor[c] + inset;
+        }
+
+        // high >= low per channel, so Color0 >= Color1 and the block is always in 4 color mode unless they are equal
+        endpoints.Color0 = packRGB565(high[0], high[1], high[2]);
+        endpoints.Color1 = packRGB565(low[0], low[1], low[2]);
+        if (endpoints.Color0 == endpoints.Color1) {
+            return endpoints;
+        }
+
+        int32_t end[3]{};
+        expandRGB565(endpoints.Color0, endpoints.Origin);
+        expandRGB565(endpoints.Color1, end);
+        for (int32_t c = 0; c < 3; ++c) {
+            endpoints.Axis[c] = end[c] - endpoints.Origin[c];
+            endpoints.AxisLengthSq += endpoints.Axis[c] * endpoints.Axis[c];
+        }
+        return endpoints;
+    }
+
+    /**
+     * Quantize the projection t of a texel to the 4 palette steps along the axis.
+     * Rounds 3 * t / length without division so SIMD kernels can use compares.
+     */
+    static constexpr uint32_t quantizeBC1Projection(int32_t t, int32_t lengthSq) {
+        const int32_t scaled = t * 6;
+        return static_cast<uint32_t>(scaled >= lengthSq) + static_cast<uint32_t>(scaled >= 3 * lengthSq) + static_cast<uint32_t>(scaled >= 5 * lengthSq);
+    }
+
+    /** Map steps along the axis to BC1 indices (0 = Color0, 1 = Color1, 2 and 3 interpolated) and write the block. */
+    static inline void writeBC1Block(const BC1Endpoints& endpoints, const uint8_t steps[16], uint8_t* out) {
+        constexpr uint32_t STEP_TO_INDEX[4] = { 0, 2, 3, 1 };
+
+        uint32_t indices = 0;
+        for (uint32_t i = 0; i < 16; ++i) {
+            indices |= STEP_TO_INDEX[steps[i]] << (i * 2);
+        }
+
+        out[0] = static_cast<uint8_t>(endpoints.Color0);
+        out[1] = static_cast<uint8_t>(endpoints.Color0 >> 8);
+        out[2] = static_cast<uint8_t>(endpoints.Color1);
+        out[3] = static_cast<uint8_t>(endpoints.Color1 >> 8);
+        out[4] = static_cast<uint8_t>(indices);
+        out[5] = static_cast<uint8_t>(indices >> 8);
+        out[6] = static_cast<uint8_t>(indices >> 16);
+        out[7] = static_cast<uint8_t>(indices >> 24);
+    }
+
+    /**
+     * Quantize a texel of a BC4 block to the 8 palette steps from max (0) to min (7).
+     * Rounds 7 * (max - value) / range without division so SIMD kernels can use compares.
+     */
+    static constexpr uint32_t quantizeBC4Value(int32_t maxValue, int32_t range, int32_t value) {
+        const int32_t scaled = 14 * (maxValue - value);
+        uint32_t step = 0;
+        for (int32_t k = 1; k < 8; ++k) {
+            step += static_cast<uint32_t>(scaled >= (2 * k - 1) * range);
+        }
+        return step;
+    }
+
+    /** Write a BC4 block in 8 value mode (max as the first endpoint). Steps are mapped to indices 0, 2..7, 1. */
+    static inline void writeBC4Block(uint8_t maxValue, uint8_t minValue, const uint8_t steps[16], uint8_t* out) {
+        constexpr uint64_t STEP_TO_INDEX[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+        uint64_t indices = 0;
+        for (uint32_t i = 0; i < 16; ++i) {
+            indices |= STEP_TO_INDEX[steps[i]] << (i * 3);
+        }
+
+        out[0] = maxValue;
+        out[1] = minValue;
+        for (uint32_t i = 0; i < 6; ++i) {
+            out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+        }
+    }
+} // namespace glass::image
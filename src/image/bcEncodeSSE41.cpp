@@ -0,0 +1,89 @@
+#include "bcEncodeX86.h"
+
+#ifdef GLASS_ARCH_X86
+
+namespace glass::image {
+    void encodeBC1BlocksSSE41(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint8_t* out) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i six = _mm_set1_epi32(6);
+
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += 8) {
+            __m128i red, green, blue;
+            loadBlockPlanar(pixels, rowPitch, red, green, blue);
+
+            const int32_t minColor[3] = { horizontalMin(red), horizontalMin(green), horizontalMin(blue) };
+            const int32_t maxColor[3] = { horizontalMax(red), horizontalMax(green), horizontalMax(blue) };
+            const BC1Endpoints endpoints = computeBC1Endpoints(minColor, maxColor);
+
+            const __m128i originRed = _mm_set1_epi16(static_cast<int16_t>(endpoints.Origin[0]));
+            const __m128i originGreen = _mm_set1_epi16(static_cast<int16_t>(endpoints.Origin[1]));
+            const __m128i originBlue = _mm_set1_epi16(static_cast<int16_t>(endpoints.Origin[2]));
+            const __m128i axisRedGreen = _mm_set1_epi32(packFactors(endpoints.Axis[0], endpoints.Axis[1]));
+            const __m128i axisBlue = _mm_set1_epi32(packFactors(endpoints.Axis[2], 0));
+
+            // scaled >= n * length <=> scaled > n * length - 1
+            const __m128i threshold1 = _mm_set1_epi32(endpoints.AxisLengthSq - 1);
+            const __m128i threshold3 = _mm_set1_epi32(endpoints.AxisLengthSq * 3 - 1);
+            const __m128i threshold5 = _mm_set1_epi32(endpoints.AxisLengthSq * 5 - 1);
+
+            __m128i steps16[2];
+            for (int32_t half = 0; half < 2; ++half) {
+                const __m128i r = _mm_sub_epi16(_mm_cvtepu8_epi16(half ? _mm_srli_si128(red, 8) : red), originRed);
+                const __m128i g = _mm_sub_epi16(_mm_cvtepu8_epi16(half ? _mm_srli_si128(green, 8) : green), originGreen);
+                const __m128i b = _mm_sub_epi16(_mm_cvtepu8_epi16(half ? _mm_srli_si128(blue, 8) : blue), originBlue);
+
+                __m128i steps32[2];
+                for (int32_t quarter = 0; quarter < 2; ++quarter) {
+                    const __m128i redGreen = quarter ? _mm_unpackhi_epi16(r, g) : _mm_unpacklo_epi16(r, g);
+                    const __m128i blueZero = quarter ? _mm_unpackhi_epi16(b, zero) : _mm_unpacklo_epi16(b, zero);
+                    const __m128i t = _mm_add_epi32(_mm_madd_epi16(redGreen, axisRedGreen), _mm_madd_epi16(blueZero, axisBlue));
+                    const __m128i scaled = _mm_mullo_epi32(t, six);
+
+                    __m128i step = _mm_sub_epi32(zero, _mm_cmpgt_epi32(scaled, threshold1));
+                    step = _mm_sub_epi32(step, _mm_cmpgt_epi32(scaled, threshold3));
+                    step = _mm_sub_epi32(step, _mm_cmpgt_epi32(scaled, threshold5));
+                    steps32[quarter] = step;
+                }
+                steps16[half] = _mm_packs_epi32(steps32[0], steps32[1]);
+            }
+
+            alignas(16) uint8_t steps[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(steps), _mm_packs_epi16(steps16[0], steps16[1]));
+            writeBC1Block(endpoints, steps, out);
+        }
+    }
+
+    void encodeBC4BlocksSSE41(const uint8_t* pixels, uint32_t rowPitch, uint32_t blockCount, uint32_t channel, uint32_t outStride, uint8_t* out) {
+        const __m128i fourteen = _mm_set1_epi16(14);
+
+        for (uint32_t block = 0; block < blockCount; ++block, pixels += 16, out += outStride) {
+            const __m128i values = loadBlockChannel(pixels, rowPitch, channel);
+            const uint8_t minValue = horizontalMin(values);
+            const uint8_t maxValue = horizontalMax(values);
+            const int32_t range = maxValue - minValue;
+
+            __m128i thresholds[7];
+            for (int32_t k = 1; k < 8; ++k) {
+                thresholds[k - 1] = _mm_set1_epi16(static_cast<int16_t>((2 * k - 1) * range - 1));
+            }
+
+            const __m128i maxValues = _mm_set1_epi16(maxValue);
+            __m128i steps16[2];
+            for (int32_t half = 0; half < 2; ++half) {
+                const __m128i v = _mm_cvtepu8_epi16(half ? _mm_srli_si128(values, 8) : values);
+                const __m128i scaled = _mm_mullo_epi16(_mm_sub_epi16(maxValues, v), fourteen);
+
+                __m128i step = _mm_setzero_si128();
+                for (const __m128i& threshold : thresholds) {
+                    step = _mm_sub_epi16(step, _mm_cmpgt_epi16(scaled, threshold));
+                }
+                steps16[half] = step;
+            }
+
+            alignas(16) uint8_t steps[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(steps), _mm_packs_epi16(steps16[0], steps16[1]));
+            writeBC4Block(maxValue, minValue, steps, out);
+        }
+    }
+} // namespace glass::image
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "bcEncodeKernels.h"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+/** SSE4.1 helpers shared by the vectorized block encoders. Only include from SIMD translation units. */
+namespace glass::image {
+    static inline uint8_t horizontalMin(__m128i v) {
+        v = _mm_min_epu8(v, _mm_srli_si128(v, 8));
+        v = _mm_min_epu8(v, _mm_srli_si128(v, 4));
+        v = _mm_min_epu8(v, _mm_srli_si128(v, 2));
+        v = _mm_min_epu8(v, _mm_srli_si128(v, 1));
+        return static_cast<uint8_t>(_mm_cvtsi128_si32(v));
+    }
+
+    static inline uint8_t horizontalMax(__m128i v) {
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 8));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 4));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 2));
+        v = _mm_max_epu8(v, _mm_srli_si128(v, 1));
+        return static_cast<uint8_t>(_mm_cvtsi128_si32(v));
+    }
+
+    static inline __m128i loadRow(const uint8_t* pixels) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+    }
+
+    /** Split the 16 RGBA texels of a block into one register per channel, texels in row major order. */
+    static inline void loadBlockPlanar(const uint8_t* pixels, uint32_t rowPitch, __m128i& red, __m128i& green, __m128i& blue) {
+        const __m128i deinterleave = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        const __m128i row0 = _mm_shuffle_epi8(loadRow(pixels), deinterleave);
+        const __m128i row1 = _mm_shuffle_epi8(loadRow(pixels + rowPitch), deinterleave);
+        const __m128i row2 = _mm_shuffle_epi8(loadRow(pixels + rowPitch * 2), deinterleave);
+        const __m128i row3 = _mm_shuffle_epi8(loadRow(pixels + rowPitch * 3), deinterleave);
+
+        const __m128i redGreen01 = _mm_unpacklo_epi32(row0, row1);
+        const __m128i redGreen23 = _mm_unpacklo_epi32(row2, row3);
+        const __m128i blueAlpha01 = _mm_unpackhi_epi32(row0, row1);
+        const __m128i blueAlpha23 = _mm_unpackhi_epi32(row2, row3);
+
+        red = _mm_unpacklo_epi64(redGreen01, redGreen23);
+        green = _mm_unpackhi_epi64(redGreen01, redGreen23);
+        blue = _mm_unpacklo_epi64(blueAlpha01, blueAlpha23);
+    }
+
+    /** Gather one channel of the 16 texels of a block, texels in row major order. */
+    static inline __m128i loadBlockChannel(const uint8_t* pixels, uint32_t rowPitch, uint32_t channel) {
+        // Moves the channel of row y into bytes 4y..4y+3. Entries with the high bit set (even after adding the channel) produce 0.
+        const __m128i offset = _mm_set1_epi8(static_cast<char>(channel));
+        const __m128i select0 = _mm_add_epi8(_mm_setr_epi8(0, 4, 8, 12, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128), offset);
+        const __m128i select1 = _mm_add_epi8(_mm_setr_epi8(-128, -128, -128, -128, 0, 4, 8, 12, -128, -128, -128, -128, -128, -128, -128, -128), offset);
+        const __m128i select2 = _mm_add_epi8(_mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, 0, 4, 8, 12, -128, -128, -128, -128), offset);
+        const __m128i select3 = _mm_add_epi8(_mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 4, 8, 12), offset);
+
+        const __m128i rows01 = _mm_or_si128(_mm_shuffle_epi8(loadRow(pixels), select0), _mm_shuffle_epi8(loadRow(pixels + rowPitch), select1));
+        const __m128i rows23 = _mm_or_si128(_mm_shuffle_epi8(loadRow(pixels + rowPitch * 2), select2), _mm_shuffle_epi8(loadRow(pixels + rowPitch * 3), select3));
+        return _mm_or_si128(rows01, rows23);
+    }
+
+    /** Pairs of (a, b) 16 bit factors for _mm_madd_epi16 */
+    static inline int32_t packFactors(int32_t a, int32_t b) {
+        return static_cast<int32_t>(static_cast<uint16_t>(a) | (static_cast<uint32_t>(static_cast<uint16_t>(b)) << 16));
+    }
+} // namespace glass::image
+#endif
@@ -0,0 +1,37 @@
+#include "imageKernels.h"
+#include "atomic"
+
+namespace glass::image {
+    static ImageKernels selectImageKernels(EImageKernel requested) {
+#ifdef GLASS_ARCH_X86
+        const cpu::CpuFeatures& features = cpu::getCpuFeatures();
+        if (requested == EIK_Auto) {
+            requested = EIK_AVX2;
+        }
+
+        if (requested >= EIK_AVX2 && features.AVX2 && features.FMA) {
+            return { EIK_AVX2, encodeBC1BlocksAVX2, encodeBC4BlocksAVX2, downsampleBoxAVX2, filterVerticalAVX2, filterHorizontalAVX2, convertYUV420AVX2 };
+        }
+
+        if (requested >= EIK_SSE41 && features.SSE41) {
+            return { EIK_SSE41, encodeBC1BlocksSSE41, encodeBC4BlocksSSE41, downsampleBoxSSE41, filterVerticalSSE41, filterHorizontalSSE41, convertYUV420SSE41 };
+        }
+#endif
+        return {};
+    }
+
+    // Image processing commonly runs on worker threads, so the selection is published atomically.
+    static std::atomic<EImageKernel> GRequestedImageKernel{ EIK_Auto };
+
+    void setImageKernel(EImageKernel kernel) {
+        GRequestedImageKernel.store(kernel, std::memory_order_relaxed);
+    }
+
+    EImageKernel getImageKernel() {
+        return getImageKernels().Kernel;
+    }
+
+    ImageKernels getImageKernels() {
+        return selectImageKernels(GRequestedImageKernel.load(std::memory_order_relaxed));
+    }
+} // namespace glass::image
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "bcEncodeKernels.h"
+#include "mipKernels.h"
+#include "yuvKernels.h"
+
+namespace glass::image {
+    using PFN_EncodeBC1 = void (*)(const uint8_t*, uint32_t, uint32_t, uint8_t*);
+    using PFN_EncodeBC4 = void (*)(const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t, uint8_t*);
+    using PFN_DownsampleBox = void (*)(const float*, const float*, uint32_t, uint32_t, uint32_t, float*);
+    using PFN_FilterVertical = void (*)(const float* const[KAISER_TAPS], const float[KAISER_TAPS], uint32_t, float*);
+    using PFN_FilterHorizontal = void (*)(const float*, uint32_t, const float[KAISER_TAPS], uint32_t, uint32_t, float*);
+    using PFN_ConvertYUV420 = void (*)(const uint8_t*, const uint8_t*, uint32_t, uint32_t, uint32_t, uint8_t*, uint8_t*, uint8_t*, uint8_t*);
+
+    struct ImageKernels {
+        EImageKernel Kernel{ EIK_Scalar };
+        PFN_EncodeBC1 EncodeBC1{ encodeBC1BlocksScalar };
+        PFN_EncodeBC4 EncodeBC4{ encodeBC4BlocksScalar };
+        PFN_DownsampleBox DownsampleBox{ downsampleBoxScalar };
+        PFN_FilterVertical FilterVertical{ filterVerticalScalar };
+        PFN_FilterHorizontal FilterHorizontal{ filterHorizontalScalar };
+        PFN_ConvertYUV420 ConvertYUV420{ convertYUV420Scalar };
+    };
+
+    /** Kernels selected with setImageKernel. Copy them once per operation, setImageKernel may run concurrently. */
+    ImageKernels getImageKernels();
+} // namespace glass::image
@@ -0,0 +1,214 @@
+#include "imageKernels.h"
+#include "parallel.h"
+#include "cassert"
+#include "cmath"
+#include "algorithm"
+#include "array"
+#include "cstring"
+
+namespace glass::image {
+    void downsampleBoxScalar(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst) {
+        for (uint32_t x = first; x < last; ++x) {
+            const uint32_t left = 2 * x * 4;
+            const uint32_t right = std::min(2 * x + 1, sourceWidth - 1) * 4;
+            for (uint32_t c = 0; c < 4; ++c) {
+                dst[x * 4 + c] = ((row0[left + c] + row0[right + c]) + (row1[left + c] + row1[right + c])) * 0.25f;
+            }
+        }
+    }
+
+    void filterVerticalScalar(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst) {
+        for (uint32_t i = 0; i < floatCount; ++i) {
+            float sum = 0.0f;
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                sum += rows[tap][i] * weights[tap];
+            }
+            dst[i] = sum;
+        }
+    }
+
+    void filterHorizontalScalar(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst) {
+        for (uint32_t x = first; x < last; ++x) {
+            float sum[4]{};
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                const int32_t sourceX = std::clamp(static_cast<int32_t>(2 * x + tap) - 2, 0, static_cast<int32_t>(sourceWidth) - 1);
+                for (uint32_t c = 0; c < 4; ++c) {
+                    sum[c] += row[sourceX * 4 + c] * weights[tap];
+                }
+            }
+            std::copy_n(sum, 4, dst + x * 4);
+        }
+    }
+
+    static double besselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int32_t k = 1; term > sum * 1e-12; ++k) {
+            const double factor = x / (2.0 * k);
+            term *= factor * factor;
+            sum += term;
+        }
+        return sum;
+    }
+
+    /** Kaiser windowed sinc (alpha 4, 3 destination texels wide) sampled at the source texel centers, normalized */
+    static std::array<float, KAISER_TAPS> computeKaiserWeights() {
+        constexpr double ALPHA = 4.0;
+        constexpr double HALF_WIDTH = 1.5;
+        constexpr double PI = 3.14159265358979323846;
+
+        std::array<double, KAISER_TAPS> weights{};
+        double total = 0.0;
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            // Distance from the destination texel center in destination texels
+            const double x = (tap - (KAISER_TAPS - 1) * 0.5) * 0.5;
+            const double sinc = std::sin(PI * x) / (PI * x);
+            const double t = x / HALF_WIDTH;
+            weights[tap] = sinc * besselI0(ALPHA * std::sqrt(1.0 - t * t)) / besselI0(ALPHA);
+            total += weights[tap];
+        }
+
+        std::array<float, KAISER_TAPS> normalized{};
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            normalized[tap] = static_cast<float>(weights[tap] / total);
+        }
+        return normalized;
+    }
+
+    static const std::array<float, 256>& getSRGBToLinearTable() {
+        static const std::array<float, 256> table = []() {
+            std::array<float, 256> values{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                const double c = i / 255.0;
+                values[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // 16 bit resolution keeps the table error well below one 8 bit step, even at the steep dark end of the curve
+    static constexpr uint32_t LINEAR_TO_SRGB_TABLE_SIZE = 1 << 16;
+
+    static const std::vector<uint8_t>& getLinearToSRGBTable() {
+        static const std::vector<uint8_t> table = []() {
+            std::vector<uint8_t> values(LINEAR_TO_SRGB_TABLE_SIZE);
+            for (uint32_t i = 0; i < LINEAR_TO_SRGB_TABLE_SIZE; ++i) {
+                const double l = static_cast<double>(i) / (LINEAR_TO_SRGB_TABLE_SIZE - 1);
+                const double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+                values[i] = static_cast<uint8_t>(std::lround(c * 255.0));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    static void decodeRow(const uint8_t* pixels, uint32_t width, bool srgb, float* out) {
+        const std::array<float, 256>& toLinear = getSRGBToLinearTable();
+        for (uint32_t i = 0; i < width * 4; ++i) {
+            out[i] = srgb && (i & 3) != 3 ? toLinear[pixels[i]] : pixels[i] * (1.0f / 255.0f);
+        }
+    }
+
+    static void encodeRow(const float* texels, uint32_t width, bool srgb, uint8_t* out) {
+        const std::vector<uint8_t>& toSRGB = getLinearToSRGBTable();
+        for (uint32_t i = 0; i < width * 4; ++i) {
+            const float value = std::clamp(texels[i], 0.0f, 1.0f);
+            if (srgb && (i & 3) != 3) {
+                out[i] = toSRGB[static_cast<uint32_t>(value * (LINEAR_TO_SRGB_TABLE_SIZE - 1) + 0.5f)];
+            } else {
+                out[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+            }
+        }
+    }
+
+    // Rows per thread below which spawning threads costs more than it saves
+    static constexpr uint32_t MIN_ROWS_PER_THREAD = 32;
+
+    MipChain generateMipChain(const ImageView& source, const MipChainSpec& spec) {
+        assert(source.Pixels && source.Width > 0 && source.Height > 0);
+
+        const uint32_t width = static_cast<uint32_t>(source.Width);
+        const uint32_t height = static_cast<uint32_t>(source.Height);
+        const uint32_t rowPitch = source.RowPitch != 0 ? source.RowPitch : width * 4;
+        const uint32_t fullChain = gfx::getMipLevelCount(source.Width, source.Height);
+        const uint32_t levelCount = spec.MipLevels == 0 ? fullChain : std::min(spec.MipLevels, fullChain);
+
+        MipChain chain{};
+        chain.Width = source.Width;
+        chain.Height = source.Height;
+
+        std::vector<size_t> offsets(levelCount);
+        size_t totalSize = 0;
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            offsets[level] = totalSize;
+            totalSize += static_cast<size_t>(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * 4;
+        }
+        chain.Pixels.resize(totalSize);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            chain.Levels.push_back(chain.Pixels.data() + offsets[level]);
+        }
+
+        for (uint32_t y = 0; y < height; ++y) {
+            std::memcpy(chain.Pixels.data() + static_cast<size_t>(y) * width * 4, source.Pixels + static_cast<size_t>(y) * rowPitch, width * 4);
+        }
+
+        if (levelCount == 1) {
+            return chain;
+        }
+
+        const ImageKernels kernels = getImageKernels();
+        const uint32_t threadCount = spec.ThreadCount != 0 ? spec.ThreadCount : std::max(std::thread::hardware_concurrency(), 1u);
+        const std::array<float, KAISER_TAPS> weights = computeKaiserWeights();
+
+        // Levels are filtered from the previous level, kept in linear float to avoid rounding twice
+        std::vector<float> current(static_cast<size_t>(width) * height * 4);
+        std::vector<float> next{};
+        parallelFor(height, std::clamp(height / MIN_ROWS_PER_THREAD, 1u, threadCount), [&](size_t first, size_t last) {
+            for (size_t y = first; y < last; ++y) {
+                decodeRow(source.Pixels + y * rowPitch, width, spec.SRGB, current.data() + y * width * 4);
+            }
+        });
+
+        for (uint32_t level = 1; level < levelCount; ++level) {
+            const uint32_t sourceWidth = std::max(width >> (level - 1), 1u);
+            const uint32_t sourceHeight = std::max(height >> (level - 1), 1u);
+            const uint32_t levelWidth = std::max(width >> level, 1u);
+            const uint32_t levelHeight = std::max(height >> level, 1u);
+            next.resize(static_cast<size_t>(levelWidth) * levelHeight * 4);
+
+            parallelFor(levelHeight, std::clamp(levelHeight / MIN_ROWS_PER_THREAD, 1u, threadCount), [&](size_t first, size_t last) {
+                std::vector<float> filtered(spec.Filter == EMF_Kaiser ? sourceWidth * 4 : 0);
+
+                for (size_t y = first; y < last; ++y) {
+                    float* dst = next.data() + y * levelWidth * 4;
+
+                    if (spec.Filter == EMF_Kaiser) {
+                        const float* rows[KAISER_TAPS];
+                        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                            const int32_t sourceY = std::clamp(static_cast<int32_t>(2 * y + tap) - 2, 0, static_cast<int32_t>(sourceHeight) - 1);
+                            rows[tap] = current.data() + static_cast<size_t>(sourceY) * sourceWidth * 4;
+                        }
+
+                        kernels.FilterVertical(rows, weights.data(), sourceWidth * 4, filtered.data());
+                        kernels.FilterHorizontal(filtered.data(), sourceWidth, weights.data(), 0, levelWidth, dst);
+                    } else {
+                        const float* row0 = current.data() + 2 * y * sourceWidth * 4;
+                        const float* row1 = current.data() + std::min<size_t>(2 * y + 1, sourceHeight - 1) * sourceWidth * 4;
+                        if (sourceWidth >= 2) {
+                            kernels.DownsampleBox(row0, row1, sourceWidth, 0, levelWidth, dst);
+                        } else {
+                            downsampleBoxScalar(row0, row1, sourceWidth, 0, levelWidth, dst);
+                        }
+                    }
+
+                    encodeRow(dst, levelWidth, spec.SRGB, chain.Pixels.data() + offsets[level] + y * levelWidth * 4);
+                }
+            });
+
+            std::swap(current, next);
+        }
+
+        return chain;
+    }
+} // namespace glass::image
@@ -0,0 +1,80 @@
+#include "mipKernels.h"
+#include "algorithm"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::image {
+    // Two RGBA texels per register
+
+    void downsampleBoxAVX2(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst) {
+        const __m256 quarter = _mm256_set1_ps(0.25f);
+
+        uint32_t x = first;
+        for (; x + 2 <= last; x += 2) {
+            // Source texels 2x .. 2x+3 of both rows. Pair them up as (2x, 2x+2) + (2x+1, 2x+3).
+            const __m256 top01 = _mm256_loadu_ps(row0 + x * 8);
+            const __m256 top23 = _mm256_loadu_ps(row0 + x * 8 + 8);
+            const __m256 bottom01 = _mm256_loadu_ps(row1 + x * 8);
+            const __m256 bottom23 = _mm256_loadu_ps(row1 + x * 8 + 8);
+
+            const __m256 top = _mm256_add_ps(_mm256_permute2f128_ps(top01, top23, 0x20), _mm256_permute2f128_ps(top01, top23, 0x31));
+            const __m256 bottom = _mm256_add_ps(_mm256_permute2f128_ps(bottom01, bottom23, 0x20), _mm256_permute2f128_ps(bottom01, bottom23, 0x31));
+            _mm256_storeu_ps(dst + x * 4, _mm256_mul_ps(_mm256_add_ps(top, bottom), quarter));
+        }
+
+        downsampleBoxScalar(row0, row1, sourceWidth, x, last, dst);
+    }
+
+    void filterVerticalAVX2(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst) {
+        __m256 weight[KAISER_TAPS];
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            weight[tap] = _mm256_set1_ps(weights[tap]);
+        }
+
+        uint32_t i = 0;
+        for (; i + 8 <= floatCount; i += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                sum = _mm256_fmadd_ps(_mm256_loadu_ps(rows[tap] + i), weight[tap], sum);
+            }
+            _mm256_storeu_ps(dst + i, sum);
+        }
+
+        // Odd texel count leaves a single texel
+        for (; i < floatCount; i += 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                sum = _mm_fmadd_ps(_mm_loadu_ps(rows[tap] + i), _mm256_castps256_ps128(weight[tap]), sum);
+            }
+            _mm_storeu_ps(dst + i, sum);
+        }
+    }
+
+    void filterHorizontalAVX2(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst) {
+        uint32_t interiorFirst, interiorLast;
+        getKaiserInteriorRange(sourceWidth, first, last, interiorFirst, interiorLast);
+
+        __m256 weight[KAISER_TAPS];
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            weight[tap] = _mm256_set1_ps(weights[tap]);
+        }
+
+        filterHorizontalScalar(row, sourceWidth, weights, first, interiorFirst, dst);
+
+        uint32_t x = interiorFirst;
+        for (; x + 2 <= interiorLast; x += 2) {
+            // Taps of texel x + 1 start two source texels after the taps of texel x
+            const float* taps = row + (2 * x - 2) * 4;
+            __m256 sum = _mm256_setzero_ps();
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                const __m256 pair = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(taps + tap * 4)), _mm_loadu_ps(taps + tap * 4 + 8), 1);
+                sum = _mm256_fmadd_ps(pair, weight[tap], sum);
+            }
+            _mm256_storeu_ps(dst + x * 4, sum);
+        }
+
+        filterHorizontalScalar(row, sourceWidth, weights, x, last, dst);
+    }
+} // namespace glass::image
+#endif
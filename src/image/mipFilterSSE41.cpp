@@ -0,0 +1,59 @@
+#include "mipKernels.h"
+#include "algorithm"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::image {
+    // One RGBA texel per register
+
+    void downsampleBoxSSE41(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst) {
+        (void)sourceWidth;
+        const __m128 quarter = _mm_set1_ps(0.25f);
+        for (uint32_t x = first; x < last; ++x) {
+            const float* top = row0 + x * 8;
+            const float* bottom = row1 + x * 8;
+            const __m128 topSum = _mm_add_ps(_mm_loadu_ps(top), _mm_loadu_ps(top + 4));
+            const __m128 bottomSum = _mm_add_ps(_mm_loadu_ps(bottom), _mm_loadu_ps(bottom + 4));
+            _mm_storeu_ps(dst + x * 4, _mm_mul_ps(_mm_add_ps(topSum, bottomSum), quarter));
+        }
+    }
+
+    void filterVerticalSSE41(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst) {
+        __m128 weight[KAISER_TAPS];
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            weight[tap] = _mm_set1_ps(weights[tap]);
+        }
+
+        // Rows hold whole RGBA texels, so floatCount is a multiple of 4
+        for (uint32_t i = 0; i < floatCount; i += 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[tap] + i), weight[tap]));
+            }
+            _mm_storeu_ps(dst + i, sum);
+        }
+    }
+
+    void filterHorizontalSSE41(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst) {
+        uint32_t interiorFirst, interiorLast;
+        getKaiserInteriorRange(sourceWidth, first, last, interiorFirst, interiorLast);
+
+        __m128 weight[KAISER_TAPS];
+        for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+            weight[tap] = _mm_set1_ps(weights[tap]);
+        }
+
+        filterHorizontalScalar(row, sourceWidth, weights, first, interiorFirst, dst);
+        for (uint32_t x = interiorFirst; x < interiorLast; ++x) {
+            const float* taps = row + (2 * x - 2) * 4;
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t tap = 0; tap < KAISER_TAPS; ++tap) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + tap * 4), weight[tap]));
+            }
+            _mm_storeu_ps(dst + x * 4, sum);
+        }
+        filterHorizontalScalar(row, sourceWidth, weights, interiorLast, last, dst);
+    }
+} // namespace glass::image
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "cpuFeatures.h"
+#include "algorithm"
+
+namespace glass::image {
+    /**
+     * Mip filters work on rows of linear RGBA float texels (4 floats per texel). Every destination texel of a
+     * level covers 2x2 source texels, sizes are halved and rounded down like in GL.
+     */
+
+    /** Source texels the Kaiser filter reads along each axis. Destination texel x is centered between source texels 2x and 2x+1. */
+    static constexpr uint32_t KAISER_TAPS = 6;
+
+    /**
+     * Average 2x2 source texels into texels [first, last) of dst. row1 is the row below row0 (or row0 again on 1 texel high levels).
+     * The vectorized kernels require a source width of at least 2.
+     */
+    void downsampleBoxScalar(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst);
+
+    /** Weighted sum of KAISER_TAPS rows, floatCount floats each */
+    void filterVerticalScalar(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst);
+
+    /** Filter texels [first, last) of dst from a row of sourceWidth texels. Taps past the row edges are clamped. */
+    void filterHorizontalScalar(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst);
+
+#ifdef GLASS_ARCH_X86
+    void downsampleBoxSSE41(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst);
+    void filterVerticalSSE41(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst);
+    void filterHorizontalSSE41(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst);
+
+    void downsampleBoxAVX2(const float* row0, const float* row1, uint32_t sourceWidth, uint32_t first, uint32_t last, float* dst);
+    void filterVerticalAVX2(const float* const rows[KAISER_TAPS], const float weights[KAISER_TAPS], uint32_t floatCount, float* dst);
+    void filterHorizontalAVX2(const float* row, uint32_t sourceWidth, const float weights[KAISER_TAPS], uint32_t first, uint32_t last, float* dst);
+#endif
+
+    /** Destination texels whose taps all lie inside a row of sourceWidth texels, so vectorized kernels need no clamping */
+    static constexpr void getKaiserInteriorRange(uint32_t sourceWidth, uint32_t first, uint32_t last, uint32_t& interiorFirst, uint32_t& interiorLast) {
+        // Taps of texel x are 2x-2 .. 2x+3
+        const uint32_t lowest = 1;
+        const uint32_t highest = sourceWidth >= 4 ? (sourceWidth - 4) / 2 + 1 : 0;
+        interiorFirst = std::clamp(lowest, first, last);
+        interiorLast = std::clamp(highest, interiorFirst, last);
+    }
+} // namespace glass::image
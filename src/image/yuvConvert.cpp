@@ -0,0 +1,63 @@
+#include "yuvKernels.h"
+#include "imageKernels.h"
+#include "cassert"
+
+namespace glass::image {
+    void convertYUV420Scalar(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed) {
+        for (uint32_t c = first; c < last; ++c) {
+            const uint32_t x0 = 2 * c;
+            const uint32_t x1 = x0 + 1 < width ? x0 + 1 : x0;
+
+            const uint8_t* p[4] = { row0 + x0 * 4, row0 + x1 * 4, row1 + x0 * 4, row1 + x1 * 4 };
+            lumaRow0[x0] = static_cast<uint8_t>(getLumaFromRGB(p[0][0], p[0][1], p[0][2]));
+            lumaRow1[x0] = static_cast<uint8_t>(getLumaFromRGB(p[2][0], p[2][1], p[2][2]));
+            if (x1 != x0) {
+                lumaRow0[x1] = static_cast<uint8_t>(getLumaFromRGB(p[1][0], p[1][1], p[1][2]));
+                lumaRow1[x1] = static_cast<uint8_t>(getLumaFromRGB(p[3][0], p[3][1], p[3][2]));
+            }
+
+            const int32_t r = (p[0][0] + p[1][0] + p[2][0] + p[3][0] + 2) >> 2;
+            const int32_t g = (p[0][1] + p[1][1] + p[2][1] + p[3][1] + 2) >> 2;
+            const int32_t b = (p[0][2] + p[1][2] + p[2][2] + p[3][2] + 2) >> 2;
+            chromaBlue[c] = static_cast<uint8_t>(getChromaBlueFromRGB(r, g, b));
+            chromaRed[c] = static_cast<uint8_t>(getChromaRedFromRGB(r, g, b));
+        }
+    }
+
+    void convertToYUV420(const uint8_t* firstRow, int64_t rowPitch, uint32_t width, uint32_t height, uint8_t* out) {
+        const ImageKernels kernels = getImageKernels();
+
+        const uint32_t chromaWidth = (width + 1) / 2;
+        const uint32_t chromaHeight = (height + 1) / 2;
+        uint8_t* luma = out;
+        uint8_t* chromaBlue = luma + static_cast<uint64_t>(width) * height;
+        uint8_t* chromaRed = chromaBlue + static_cast<uint64_t>(chromaWidth) * chromaHeight;
+
+        for (uint32_t y = 0; y < height; y += 2) {
+            const uint32_t y1 = y + 1 < height ? y + 1 : y;
+            kernels.ConvertYUV420(
+                firstRow + rowPitch * y,
+                firstRow + rowPitch * y1,
+                width,
+                0,
+                chromaWidth,
+                luma + static_cast<uint64_t>(width) * y,
+                luma + static_cast<uint64_t>(width) * y1,
+                chromaBlue + static_cast<uint64_t>(chromaWidth) * (y / 2),
+                chromaRed + static_cast<uint64_t>(chromaWidth) * (y / 2));
+        }
+    }
+
+    uint64_t getYUV420ImageSize(int32_t width, int32_t height) {
+        const uint64_t chromaSize = static_cast<uint64_t>((width + 1) / 2) * ((height + 1) / 2);
+        return static_cast<uint64_t>(width) * height + chromaSize * 2;
+    }
+
+    void convertImageToYUV420(const ImageView& source, std::span<uint8_t> out) {
+        assert(source.Pixels && source.Width > 0 && source.Height > 0);
+        assert(out.size() >= getYUV420ImageSize(source.Width, source.Height));
+
+        const uint32_t rowPitch = source.RowPitch != 0 ? source.RowPitch : static_cast<uint32_t>(source.Width) * 4;
+        convertToYUV420(source.Pixels, rowPitch, static_cast<uint32_t>(source.Width), static_cast<uint32_t>(source.Height), out.data());
+    }
+} // namespace glass::image
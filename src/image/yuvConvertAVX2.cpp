@@ -0,0 +1,72 @@
+#include "yuvKernels.h"
+#include "algorithm"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::image {
+    // Lanes of the 256 bit unpack and horizontal add instructions stay separate, results are reordered after packing
+
+    static inline __m256i roundAndOffset(__m256i sum, __m256i offset) {
+        return _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(128)), 8), offset);
+    }
+
+    // Luma of 8 pixels: lane 0 holds pixels 0-3, lane 1 pixels 4-7
+    static inline __m256i getLuma(__m256i pixels, __m256i coefficients, __m256i offset) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i sum = _mm256_hadd_epi32(
+            _mm256_madd_epi16(_mm256_unpacklo_epi8(pixels, zero), coefficients),
+            _mm256_madd_epi16(_mm256_unpackhi_epi8(pixels, zero), coefficients));
+        return roundAndOffset(sum, offset);
+    }
+
+    static inline void storeLuma(const uint8_t* row, uint8_t* luma, __m256i coefficients, __m256i offset) {
+        const __m256i luma07 = getLuma(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)), coefficients, offset);
+        const __m256i luma815 = getLuma(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + 32)), coefficients, offset);
+
+        // Packing interleaves the lanes: (0-3, 8-11 | 4-7, 12-15)
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(luma07, luma815), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(luma), _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1)));
+    }
+
+    // Rounded 2x2 averages of four chroma columns from eight pixels of both rows: (c0, c1 | c2, c3) as 16 bit RGBA
+    static inline __m256i averageQuads(__m256i top, __m256i bottom) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i sumLow = _mm256_add_epi16(_mm256_unpacklo_epi8(top, zero), _mm256_unpacklo_epi8(bottom, zero));
+        const __m256i sumHigh = _mm256_add_epi16(_mm256_unpackhi_epi8(top, zero), _mm256_unpackhi_epi8(bottom, zero));
+        const __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(sumLow, sumHigh), _mm256_unpackhi_epi64(sumLow, sumHigh));
+        return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), 2);
+    }
+
+    static inline void storeChroma(__m256i average03, __m256i average47, uint8_t* chroma, __m256i coefficients) {
+        // The horizontal add yields (c0, c1, c4, c5 | c2, c3, c6, c7)
+        const __m256i sum = _mm256_hadd_epi32(_mm256_madd_epi16(average03, coefficients), _mm256_madd_epi16(average47, coefficients));
+        const __m256i value = _mm256_permutevar8x32_epi32(roundAndOffset(sum, _mm256_set1_epi32(128)), _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+        const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(chroma), _mm_packus_epi16(packed, packed));
+    }
+
+    void convertYUV420AVX2(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed) {
+        const __m256i lumaCoefficients = _mm256_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0, 66, 129, 25, 0, 66, 129, 25, 0);
+        const __m256i blueCoefficients = _mm256_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0, -38, -74, 112, 0, -38, -74, 112, 0);
+        const __m256i redCoefficients = _mm256_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0, 112, -94, -18, 0, 112, -94, -18, 0);
+        const __m256i lumaOffset = _mm256_set1_epi32(16);
+
+        // Eight chroma columns (16 pixels) per iteration. The rest goes to the SSE4.1 kernel.
+        const uint32_t vectorLast = std::min(last, width / 2);
+        uint32_t c = first;
+        for (; c + 8 <= vectorLast; c += 8) {
+            const uint32_t x = 2 * c;
+            storeLuma(row0 + x * 4, lumaRow0 + x, lumaCoefficients, lumaOffset);
+            storeLuma(row1 + x * 4, lumaRow1 + x, lumaCoefficients, lumaOffset);
+
+            const __m256i average03 = averageQuads(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + x * 4)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + x * 4)));
+            const __m256i average47 = averageQuads(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(row0 + x * 4 + 32)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row1 + x * 4 + 32)));
+            storeChroma(average03, average47, chromaBlue + c, blueCoefficients);
+            storeChroma(average03, average47, chromaRed + c, redCoefficients);
+        }
+
+        convertYUV420SSE41(row0, row1, width, c, last, lumaRow0, lumaRow1, chromaBlue, chromaRed);
+    }
+} // namespace glass::image
+#endif
@@ -0,0 +1,68 @@
+#include "yuvKernels.h"
+#include "cstring"
+#include "algorithm"
+
+#ifdef GLASS_ARCH_X86
+    #include "immintrin.h"
+
+namespace glass::image {
+    // Coefficient dot product of four pixels held as two registers of 16 bit RGBA pairs
+    static inline __m128i dotRGB(__m128i pixels01, __m128i pixels23, __m128i coefficients) {
+        return _mm_hadd_epi32(_mm_madd_epi16(pixels01, coefficients), _mm_madd_epi16(pixels23, coefficients));
+    }
+
+    static inline __m128i roundAndOffset(__m128i sum, __m128i offset) {
+        return _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(128)), 8), offset);
+    }
+
+    static inline void storeLuma(const uint8_t* row, uint8_t* luma, __m128i coefficients, __m128i offset) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i pixels03 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+        const __m128i pixels47 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 16));
+
+        const __m128i luma03 = roundAndOffset(dotRGB(_mm_cvtepu8_epi16(pixels03), _mm_unpackhi_epi8(pixels03, zero), coefficients), offset);
+        const __m128i luma47 = roundAndOffset(dotRGB(_mm_cvtepu8_epi16(pixels47), _mm_unpackhi_epi8(pixels47, zero), coefficients), offset);
+        const __m128i packed = _mm_packs_epi32(luma03, luma47);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(luma), _mm_packus_epi16(packed, packed));
+    }
+
+    // Rounded 2x2 averages of two chroma columns from four pixels of both rows, as 16 bit RGBA
+    static inline __m128i averageQuad(__m128i top, __m128i bottom) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i sum01 = _mm_add_epi16(_mm_cvtepu8_epi16(top), _mm_cvtepu8_epi16(bottom));
+        const __m128i sum23 = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+        const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(sum01, sum23), _mm_unpackhi_epi64(sum01, sum23));
+        return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+    }
+
+    static inline void storeChroma(__m128i average01, __m128i average23, uint8_t* chroma, __m128i coefficients) {
+        const __m128i value = roundAndOffset(dotRGB(average01, average23, coefficients), _mm_set1_epi32(128));
+        const __m128i packed = _mm_packs_epi32(value, value);
+        const int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+        std::memcpy(chroma, &bytes, sizeof(bytes));
+    }
+
+    void convertYUV420SSE41(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed) {
+        const __m128i lumaCoefficients = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+        const __m128i blueCoefficients = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+        const __m128i redCoefficients = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+        const __m128i lumaOffset = _mm_set1_epi32(16);
+
+        // Four chroma columns (8 pixels) per iteration. The odd edge column is left to the scalar kernel.
+        const uint32_t vectorLast = std::min(last, width / 2);
+        uint32_t c = first;
+        for (; c + 4 <= vectorLast; c += 4) {
+            const uint32_t x = 2 * c;
+            storeLuma(row0 + x * 4, lumaRow0 + x, lumaCoefficients, lumaOffset);
+            storeLuma(row1 + x * 4, lumaRow1 + x, lumaCoefficients, lumaOffset);
+
+            const __m128i average01 = averageQuad(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 4)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 4)));
+            const __m128i average23 = averageQuad(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 4 + 16)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 4 + 16)));
+            storeChroma(average01, average23, chromaBlue + c, blueCoefficients);
+            storeChroma(average01, average23, chromaRed + c, redCoefficients);
+        }
+
+        convertYUV420Scalar(row0, row1, width, c, last, lumaRow0, lumaRow1, chromaBlue, chromaRed);
+    }
+} // namespace glass::image
+#endif
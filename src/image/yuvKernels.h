@@ -0,0 +1,39 @@
+#pragma once
+
+#include "glass/glass.h"
+#include "cpuFeatures.h"
+
+namespace glass::image {
+    /**
+     * RGBA8 to planar YUV 4:2:0 with BT.601 limited range coefficients in 8 bit fixed point.
+     * Chroma is computed from the rounded average of 2x2 pixels (centered siting, C420jpeg in Y4M).
+     * All kernels produce identical output, checked by glass_microbench.
+     */
+
+    static constexpr int32_t getLumaFromRGB(int32_t r, int32_t g, int32_t b) {
+        return ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+    }
+
+    static constexpr int32_t getChromaBlueFromRGB(int32_t r, int32_t g, int32_t b) {
+        return ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+    }
+
+    static constexpr int32_t getChromaRedFromRGB(int32_t r, int32_t g, int32_t b) {
+        return ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+    }
+
+    /**
+     * Convert chroma columns [first, last) of a pair of rows. Column c covers pixels 2c and 2c+1 of both rows, the last column of
+     * an odd width repeats the edge pixel. row1 is the row below row0 (or row0 again for the last row of an odd height).
+     * Luma of row1 goes to lumaRow1, which may alias lumaRow0 when row1 is row0.
+     */
+    void convertYUV420Scalar(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed);
+
+#ifdef GLASS_ARCH_X86
+    void convertYUV420SSE41(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed);
+    void convertYUV420AVX2(const uint8_t* row0, const uint8_t* row1, uint32_t width, uint32_t first, uint32_t last, uint8_t* lumaRow0, uint8_t* lumaRow1, uint8_t* chromaBlue, uint8_t* chromaRed);
+#endif
+
+    /** Convert a whole image. Rows start rowPitch bytes apart, a negative pitch walks the rows bottom up (e.g. GL readbacks). */
+    void convertToYUV420(const uint8_t* firstRow, int64_t rowPitch, uint32_t width, uint32_t height, uint8_t* out);
+} // namespace glass::image
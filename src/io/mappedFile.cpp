@@ -0,0 +1,84 @@
+#include "mappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include "windows.h"
+#else
+    #include "fcntl.h"
+    #include "sys/mman.h"
+    #include "sys/stat.h"
+    #include "unistd.h"
+#endif
+
+namespace glass::io {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            return;
+        }
+
+        m_Data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return;
+        }
+
+        m_Size = static_cast<uint64_t>(size.QuadPart);
+        m_File = file;
+        m_Mapping = mapping;
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_Data) {
+            UnmapViewOfFile(m_Data);
+            CloseHandle(m_Mapping);
+            CloseHandle(m_File);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return;
+        }
+
+        struct stat status{};
+        if (fstat(file, &status) != 0 || status.st_size == 0) {
+            close(file);
+            return;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping keeps its own reference to the file
+        close(file);
+        if (data == MAP_FAILED) {
+            return;
+        }
+
+        m_Data = static_cast<const uint8_t*>(data);
+        m_Size = static_cast<uint64_t>(status.st_size);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_Data) {
+            munmap(const_cast<uint8_t*>(m_Data), static_cast<size_t>(m_Size));
+        }
+    }
+#endif
+} // namespace glass::io
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "cstdint"
+#include "string"
+
+namespace glass::io {
+    /** Read-only memory mapping of a whole file. The mapping stays valid for the lifetime of the object. */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool isOpen() const { return m_Data != nullptr; }
+        const uint8_t* getData() const { return m_Data; }
+        uint64_t getSize() const { return m_Size; }
+
+    private:
+        const uint8_t* m_Data{};
+        uint64_t m_Size{};
+
+#ifdef _WIN32
+        void* m_File{};
+        void* m_Mapping{};
+#endif
+    };
+} // namespace glass::io
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "cstdint"
+#include "algorithm"
+#include "thread"
+#include "vector"
+
+namespace glass {
+    /**
+     * Split [0, count) into contiguous ranges and call func(begin, end) for each range on its own thread.
+     * The calling thread processes the first range. Returns once every range is done.
+     * @param threadCount Maximum number of threads. 0 uses all hardware threads.
+     */
+    template<typename Func>
+    void parallelFor(size_t count, uint32_t threadCount, Func&& func) {
+        if (threadCount == 0) {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        const size_t rangeCount = std::min<size_t>(threadCount, count);
+        if (rangeCount <= 1) {
+            if (count > 0) {
+                func(size_t{ 0 }, count);
+            }
+            return;
+        }
+
+        const size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+        std::vector<std::jthread> workers;
+        workers.reserve(rangeCount - 1);
+        for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+            const size_t end = std::min(begin + rangeSize, count);
+            workers.emplace_back([&func, begin, end]() { func(begin, end); });
+        }
+
+        func(size_t{ 0 }, std::min(rangeSize, count));
+    }
+} // namespace glass